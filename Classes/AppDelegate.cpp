@@ -24,6 +24,7 @@
 
 #include "AppDelegate.h"
 #include "controllers/GameController.h"
+#include "utils/TraceUtils.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -98,6 +99,8 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     register_all_packages();
 
+    GAME_TRACE_THREAD_NAME("Main");
+
     // 创建游戏场景
     auto scene = Scene::create();
 
@@ -122,6 +125,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
 
+    // 开启跟踪时，每次切到后台都把记录的事件导出到可写目录，用chrome://tracing或Perfetto打开
+    GAME_TRACE_WRITE(FileUtils::getInstance()->getWritablePath() + "game_trace.json");
+
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
 #elif USE_SIMPLE_AUDIO_ENGINE
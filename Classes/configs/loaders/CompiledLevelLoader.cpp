@@ -0,0 +1,137 @@
+#include "CompiledLevelLoader.h"
+#include "LevelConfigLoader.h"
+#include "../models/CardResConfig.h"
+#include "../models/LevelPack.h"
+#include "../../utils/CardOcclusionUtils.h"
+#include "../../utils/LogUtils.h"
+#include "../../utils/TraceUtils.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef GAME_CORE_HEADLESS
+#include "cocos2d.h"
+#endif
+
+namespace
+{
+    /**
+     * @brief 按8字节对齐追加一段数据，返回该段的偏移
+     */
+    uint32_t appendSection(std::string& data, const void* section, size_t size)
+    {
+        data.resize((data.size() + 7) & ~static_cast<size_t>(7), '\0');
+        const uint32_t offset = static_cast<uint32_t>(data.size());
+        if (size > 0) data.append(static_cast<const char*>(section), size);
+        return offset;
+    }
+
+    CompiledCardData makeCardData(const CardConfigData& config)
+    {
+        CompiledCardData data;
+        std::memset(&data, 0, sizeof(data));
+        data.positionX = config.position.x;
+        data.positionY = config.position.y;
+        data.zOrder = config.zOrder;
+        data.cardFace = static_cast<uint8_t>(config.cardFace);
+        data.cardSuit = static_cast<uint8_t>(config.cardSuit);
+        data.isFaceUp = config.isFaceUp ? 1 : 0;
+        return data;
+    }
+}
+
+bool CompiledLevelLoader::loadCompiledLevel(int levelId, CompiledLevel& outLevel)
+{
+    GAME_TRACE_SCOPE_VALUE("loadCompiledLevel", levelId);
+    const std::string path = getCompiledLevelPath(levelId);
+#ifdef GAME_CORE_HEADLESS
+    return outLevel.open(path);
+#else
+    // 资源在普通文件中时直接映射，在安装包内（Android）时由FileUtils读出后加载
+    auto fileUtils = cocos2d::FileUtils::getInstance();
+    const std::string fullPath = fileUtils->fullPathForFilename(path);
+    if (fullPath.empty()) return false;
+    if (outLevel.open(fullPath)) return true;
+
+    cocos2d::Data data = fileUtils->getDataFromFile(fullPath);
+    return !data.isNull() && outLevel.openFromMemory(data.getBytes(), static_cast<size_t>(data.getSize()));
+#endif
+}
+
+bool CompiledLevelLoader::isSourceUpToDate(int levelId, const CompiledLevel& compiledLevel)
+{
+#if GAME_CHECK_LEVEL_SOURCE
+    if (!compiledLevel.isValid() || compiledLevel.getSourceHash() == 0) return true;
+    if (!LevelConfigLoader::levelConfigFileExists(levelId)) return true;
+
+    const std::string content = LevelConfigLoader::readLevelConfigFile(levelId);
+    if (LevelPack::computeContentHash(content.data(), content.size()) == compiledLevel.getSourceHash()) return true;
+
+    GAME_LOG("Compiled level %d is older than its JSON, loading the JSON instead", levelId);
+    return false;
+#else
+    (void)levelId;
+    (void)compiledLevel;
+    return true;
+#endif
+}
+
+std::string CompiledLevelLoader::compileLevelConfig(const LevelConfig* levelConfig, uint64_t sourceHash)
+{
+    // 文件内容按本机内存布局写出，只能在小端序的机器上生成
+    if (!levelConfig || !CompiledLevel::isHostLittleEndian()) return "";
+
+    // 与加载JSON时一样按位置计算遮挡关系，生成器产出的配置也能直接编译
+    std::vector<CardConfigData> playfieldConfigs = levelConfig->getPlayfieldCards();
+    if (playfieldConfigs.size() + levelConfig->getStackCards().size() > static_cast<size_t>(kLevelMaxCardCount)) return "";
+    CardOcclusionUtils::computeBlockedBy(playfieldConfigs, CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+    const std::vector<int> drawRanks = CardOcclusionUtils::computeDrawRanks(playfieldConfigs);
+
+    std::vector<CompiledCardData> playfieldCards;
+    std::vector<uint16_t> blockers;
+    playfieldCards.reserve(playfieldConfigs.size());
+    for (size_t i = 0; i < playfieldConfigs.size(); i++)
+    {
+        CompiledCardData data = makeCardData(playfieldConfigs[i]);
+        data.drawRank = drawRanks[i];
+        data.blockerBegin = static_cast<uint32_t>(blockers.size());
+        data.blockerCount = static_cast<uint16_t>(playfieldConfigs[i].blockedBy.size());
+        for (int blocker : playfieldConfigs[i].blockedBy)
+        {
+            blockers.push_back(static_cast<uint16_t>(blocker));
+        }
+        playfieldCards.push_back(data);
+    }
+
+    std::vector<CompiledCardData> stackCards;
+    stackCards.reserve(levelConfig->getStackCards().size());
+    for (const auto& config : levelConfig->getStackCards())
+    {
+        stackCards.push_back(makeCardData(config));
+    }
+
+    CompiledLevelHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kCompiledLevelMagic;
+    header.version = kCompiledLevelVersion;
+    header.headerSize = sizeof(CompiledLevelHeader);
+    header.coinReward = levelConfig->getCoinReward();
+    header.playfieldCount = static_cast<uint32_t>(playfieldCards.size());
+    header.stackCount = static_cast<uint32_t>(stackCards.size());
+    header.blockerCount = static_cast<uint32_t>(blockers.size());
+    header.sourceHash = sourceHash;
+
+    std::string data(sizeof(header), '\0');
+    header.playfieldOffset = appendSection(data, playfieldCards.data(), playfieldCards.size() * sizeof(CompiledCardData));
+    header.stackOffset = appendSection(data, stackCards.data(), stackCards.size() * sizeof(CompiledCardData));
+    header.blockerOffset = appendSection(data, blockers.data(), blockers.size() * sizeof(uint16_t));
+    header.fileSize = static_cast<uint32_t>(data.size());
+    std::memcpy(&data[0], &header, sizeof(header));
+    return data;
+}
+
+std::string CompiledLevelLoader::getCompiledLevelPath(int levelId)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "levels/level_%d.bin", levelId);
+    return path;
+}
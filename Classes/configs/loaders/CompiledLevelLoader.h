@@ -0,0 +1,58 @@
+#ifndef __COMPILED_LEVEL_LOADER_H__
+#define __COMPILED_LEVEL_LOADER_H__
+
+#include "../models/CompiledLevel.h"
+#include "../models/LevelConfig.h"
+#include <string>
+
+// 开发构建加载关卡时检查关卡JSON是否改过（编译关卡和LevelConfigCache都会检查），发布构建不重新读取JSON
+#if (defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0) || (defined(GAME_CORE_HEADLESS) && !defined(NDEBUG))
+#define GAME_CHECK_LEVEL_SOURCE 1
+#else
+#define GAME_CHECK_LEVEL_SOURCE 0
+#endif
+
+/**
+ * @brief 编译关卡的加载器和编译器
+ * 关卡JSON由level_compiler工具离线编译为levels/level_N.bin，游戏中映射加载，不需要解析
+ * 编译结果记录关卡JSON的内容哈希，开发构建加载时与当前的JSON比较，JSON改过后不再使用过期的编译结果
+ */
+class CompiledLevelLoader
+{
+public:
+    /**
+     * @brief 加载编译后的关卡
+     * @param levelId 关卡ID
+     * @param outLevel 输出参数，加载成功后持有关卡文件映射
+     * @return 成功返回true，文件不存在或无效时返回false
+     */
+    static bool loadCompiledLevel(int levelId, CompiledLevel& outLevel);
+
+    /**
+     * @brief 检查编译后的关卡是否与关卡JSON一致
+     * 只在开发构建（cocos2d-x的调试构建，或未定义NDEBUG的核心库构建）中读取JSON比较内容哈希，
+     * 发布构建不读取JSON，直接返回true；JSON不存在或编译结果没有记录哈希时也返回true
+     * @param levelId 关卡ID
+     * @param compiledLevel 已加载的编译关卡（来自关卡包或.bin文件）
+     * @return 可以使用编译结果返回true，JSON在编译后被修改过返回false
+     */
+    static bool isSourceUpToDate(int levelId, const CompiledLevel& compiledLevel);
+
+    /**
+     * @brief 将关卡配置编译为二进制格式
+     * 遮挡关系和绘制层级按卡牌位置重新计算后写入
+     * @param levelConfig 关卡配置对象
+     * @param sourceHash 关卡JSON内容的哈希（见LevelPack::computeContentHash），0表示不记录
+     * @return 编译后的文件内容，配置为空、卡牌过多或本机为大端序时返回空字符串
+     */
+    static std::string compileLevelConfig(const LevelConfig* levelConfig, uint64_t sourceHash = 0);
+
+    /**
+     * @brief 获取编译后关卡文件的路径
+     * @param levelId 关卡ID
+     * @return 文件路径
+     */
+    static std::string getCompiledLevelPath(int levelId);
+};
+
+#endif // __COMPILED_LEVEL_LOADER_H__
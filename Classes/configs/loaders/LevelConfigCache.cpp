@@ -0,0 +1,176 @@
+#include "LevelConfigCache.h"
+#include "CompiledLevelLoader.h"
+#include "LevelConfigLoader.h"
+#include "../models/LevelPack.h"
+#include "../../utils/TraceUtils.h"
+#include <algorithm>
+
+LevelConfigCache::LevelConfigCache(size_t memoryBudget)
+    : _memoryBudget(memoryBudget)
+{
+}
+
+LevelConfigCache::~LevelConfigCache()
+{
+}
+
+LevelConfigCache* LevelConfigCache::getInstance()
+{
+    static LevelConfigCache instance;
+    return &instance;
+}
+
+std::shared_ptr<const LevelConfig> LevelConfigCache::getLevelConfig(int levelId)
+{
+    // 按关卡ID直接取用，不读文件；开发构建中关卡JSON可能被改过，每次都读取文件按内容哈希查找
+#if !GAME_CHECK_LEVEL_SOURCE
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto idIt = _hashesByLevelId.find(levelId);
+        if (idIt != _hashesByLevelId.end())
+        {
+            std::shared_ptr<const LevelConfig> config = touch(idIt->second, levelId);
+            if (config)
+            {
+                _stats.hits++;
+                return config;
+            }
+        }
+    }
+#endif
+
+    std::string content = LevelConfigLoader::readLevelConfigFile(levelId);
+    if (content.empty())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.misses++;
+        return nullptr;
+    }
+
+    // 内容与已缓存的关卡相同时不需要解析
+    const uint64_t contentHash = LevelPack::computeContentHash(content.data(), content.size());
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::shared_ptr<const LevelConfig> config = touch(contentHash, levelId);
+        if (config)
+        {
+            _stats.hits++;
+            return config;
+        }
+    }
+
+    std::shared_ptr<const LevelConfig> config(LevelConfigLoader::parseLevelConfigInPlace(content));
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.misses++;
+    if (!config) return nullptr;
+
+    // 解析期间其他线程可能已放入同样的内容，使用先放入的那份
+    std::shared_ptr<const LevelConfig> cached = touch(contentHash, levelId);
+    if (cached) return cached;
+
+    CacheEntry entry;
+    entry.contentHash = contentHash;
+    entry.config = config;
+    entry.memoryUsage = estimateMemoryUsage(config.get());
+    _entries.push_front(entry);
+    _entriesByHash[contentHash] = _entries.begin();
+    _stats.memoryUsage += entry.memoryUsage;
+    _stats.entryCount++;
+    touch(contentHash, levelId);
+
+    evict();
+    GAME_TRACE_COUNTER("levelConfigCacheMemory", _stats.memoryUsage);
+    return config;
+}
+
+LevelConfigCacheStats LevelConfigCache::getStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void LevelConfigCache::resetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
+}
+
+void LevelConfigCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _entriesByHash.clear();
+    _hashesByLevelId.clear();
+    _stats.memoryUsage = 0;
+    _stats.entryCount = 0;
+}
+
+void LevelConfigCache::setMemoryBudget(size_t memoryBudget)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _memoryBudget = memoryBudget;
+    evict();
+}
+
+size_t LevelConfigCache::estimateMemoryUsage(const LevelConfig* levelConfig)
+{
+    if (!levelConfig) return 0;
+
+    size_t usage = sizeof(LevelConfig);
+    auto addCards = [&usage](const std::vector<CardConfigData>& cards) {
+        usage += cards.capacity() * sizeof(CardConfigData);
+        for (const auto& card : cards)
+        {
+            usage += card.blockedBy.capacity() * sizeof(int);
+        }
+    };
+    addCards(levelConfig->getPlayfieldCards());
+    addCards(levelConfig->getStackCards());
+    return usage;
+}
+
+std::shared_ptr<const LevelConfig> LevelConfigCache::touch(uint64_t contentHash, int levelId)
+{
+    auto it = _entriesByHash.find(contentHash);
+    if (it == _entriesByHash.end()) return nullptr;
+
+    _entries.splice(_entries.begin(), _entries, it->second);
+
+    auto idIt = _hashesByLevelId.find(levelId);
+    if (idIt == _hashesByLevelId.end() || idIt->second != contentHash)
+    {
+        // 关卡文件内容变化时，旧哈希的项不再属于该关卡
+        if (idIt != _hashesByLevelId.end())
+        {
+            auto oldIt = _entriesByHash.find(idIt->second);
+            if (oldIt != _entriesByHash.end())
+            {
+                std::vector<int>& oldIds = oldIt->second->levelIds;
+                oldIds.erase(std::remove(oldIds.begin(), oldIds.end(), levelId), oldIds.end());
+            }
+        }
+        _hashesByLevelId[levelId] = contentHash;
+        it->second->levelIds.push_back(levelId);
+    }
+    return it->second->config;
+}
+
+void LevelConfigCache::evict()
+{
+    while (_stats.memoryUsage > _memoryBudget && !_entries.empty())
+    {
+        const CacheEntry& entry = _entries.back();
+        for (int levelId : entry.levelIds)
+        {
+            _hashesByLevelId.erase(levelId);
+        }
+        _entriesByHash.erase(entry.contentHash);
+        _stats.memoryUsage -= entry.memoryUsage;
+        _stats.entryCount--;
+        _stats.evictions++;
+        _entries.pop_back();
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef __LEVEL_CONFIG_CACHE_H__
+#define __LEVEL_CONFIG_CACHE_H__
+
+#include "../models/LevelConfig.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 关卡配置缓存的统计数据
+ */
+struct LevelConfigCacheStats
+{
+    uint64_t hits;          // 命中次数（不需要解析）
+    uint64_t misses;        // 未命中次数（读取并解析了关卡文件，读取或解析失败也计入）
+    uint64_t evictions;     // 因超出内存预算被淘汰的配置数量
+    size_t memoryUsage;     // 缓存中配置的估算内存占用（字节）
+    int entryCount;         // 缓存中的配置数量
+
+    LevelConfigCacheStats() : hits(0), misses(0), evictions(0), memoryUsage(0), entryCount(0) {}
+};
+
+/**
+ * @brief 关卡配置缓存
+ * 位于LevelConfigLoader之前，按内容哈希（见LevelPack::computeContentHash）缓存解析好的关卡配置，
+ * 内容相同的关卡共用一份；同时记住关卡ID对应的哈希，重玩或返回某一关时不读文件也不解析
+ * 开发构建（见GAME_CHECK_LEVEL_SOURCE）每次都读取文件重新计算哈希，关卡JSON改过后不会拿到旧的配置
+ * 超出内存预算时淘汰最久未使用的配置；配置以只读共享指针交出，被淘汰后仍在使用的配置不受影响
+ * 所有接口都是线程安全的，文件读取和解析在锁外进行
+ */
+class LevelConfigCache
+{
+public:
+    static const size_t kDefaultMemoryBudget = 4 * 1024 * 1024;    // 默认内存预算（字节）
+
+    /**
+     * @param memoryBudget 内存预算（字节）
+     */
+    explicit LevelConfigCache(size_t memoryBudget = kDefaultMemoryBudget);
+    ~LevelConfigCache();
+
+    /**
+     * @brief 获取游戏共用的缓存
+     */
+    static LevelConfigCache* getInstance();
+
+    /**
+     * @brief 获取关卡配置
+     * 未命中时通过LevelConfigLoader读取并解析，然后放入缓存；开发构建中先按当前文件内容的哈希查找
+     * @param levelId 关卡ID
+     * @return 只读的关卡配置，加载或解析失败时返回空指针
+     */
+    std::shared_ptr<const LevelConfig> getLevelConfig(int levelId);
+
+    /**
+     * @brief 获取统计数据
+     */
+    LevelConfigCacheStats getStats() const;
+
+    /**
+     * @brief 清零命中、未命中和淘汰计数
+     */
+    void resetStats();
+
+    /**
+     * @brief 清空缓存（已交出的配置不受影响）
+     */
+    void clear();
+
+    /**
+     * @brief 设置内存预算，超出时立即淘汰
+     * @param memoryBudget 内存预算（字节）
+     */
+    void setMemoryBudget(size_t memoryBudget);
+
+    /**
+     * @brief 估算关卡配置的内存占用
+     * @param levelConfig 关卡配置对象
+     * @return 字节数
+     */
+    static size_t estimateMemoryUsage(const LevelConfig* levelConfig);
+
+private:
+    LevelConfigCache(const LevelConfigCache&) = delete;
+    LevelConfigCache& operator=(const LevelConfigCache&) = delete;
+
+    /**
+     * @brief 缓存中的一项
+     */
+    struct CacheEntry
+    {
+        uint64_t contentHash;                       // 关卡文件内容的哈希
+        std::shared_ptr<const LevelConfig> config;  // 解析好的配置
+        size_t memoryUsage;                         // 估算的内存占用
+        std::vector<int> levelIds;                  // 内容为该哈希的关卡ID
+    };
+
+    typedef std::list<CacheEntry> EntryList;
+
+    /**
+     * @brief 按哈希查找并移到最近使用的位置，同时记录关卡ID（调用时需持有_mutex）
+     * @return 配置，不在缓存中时返回空指针
+     */
+    std::shared_ptr<const LevelConfig> touch(uint64_t contentHash, int levelId);
+
+    /**
+     * @brief 淘汰最久未使用的配置直到不超出预算（调用时需持有_mutex）
+     */
+    void evict();
+
+private:
+    mutable std::mutex _mutex;                                  // 保护以下所有成员
+    EntryList _entries;                                         // 按最近使用排序，头部最新
+    std::unordered_map<uint64_t, EntryList::iterator> _entriesByHash;   // 内容哈希到缓存项
+    std::unordered_map<int, uint64_t> _hashesByLevelId;         // 关卡ID到内容哈希
+    size_t _memoryBudget;                                       // 内存预算
+    LevelConfigCacheStats _stats;                               // 统计数据（memoryUsage和entryCount实时维护）
+};
+
+#endif // __LEVEL_CONFIG_CACHE_H__
@@ -1,121 +1,478 @@
 #include "LevelConfigLoader.h"
-#include "cocos2d.h"
-#include "json/document.h"
+#include "CompiledLevelLoader.h"
+#include "LevelPackLoader.h"
+#include "../models/CardResConfig.h"
+#include "../../utils/CardOcclusionUtils.h"
+#include "../../utils/LogUtils.h"
+#include "../../utils/TraceUtils.h"
+#include "json/reader.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
 
-USING_NS_CC;
+#ifdef GAME_CORE_HEADLESS
+#include <fstream>
+#include <sstream>
+#else
+#include "cocos2d.h"
+#endif
 
-LevelConfig* LevelConfigLoader::loadLevelConfig(int levelId)
+namespace
 {
-    std::string path = getLevelConfigPath(levelId);
-    std::string content = FileUtils::getInstance()->getStringFromFile(path);
-
-    if (content.empty())
+    /**
+     * @brief 读取关卡文件内容
+     * 游戏中通过FileUtils在资源搜索路径中查找；核心库构建时按相对当前目录的路径读取
+     */
+    std::string readLevelFile(const std::string& path)
     {
-        CCLOG("Failed to load level config: %s", path.c_str());
-        return nullptr;
-    }
-
-    return parseLevelConfig(content);
-}
+#ifdef GAME_CORE_HEADLESS
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file) return "";
 
-LevelConfig* LevelConfigLoader::parseLevelConfig(const std::string& jsonStr)
-{
-    rapidjson::Document doc;
-    doc.Parse(jsonStr.c_str());
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+#else
+        return cocos2d::FileUtils::getInstance()->getStringFromFile(path);
+#endif
+    }
 
-    if (doc.HasParseError())
+    bool levelFileExists(const std::string& path)
     {
-        CCLOG("Failed to parse level config JSON");
-        return nullptr;
+#ifdef GAME_CORE_HEADLESS
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        return static_cast<bool>(file);
+#else
+        return cocos2d::FileUtils::getInstance()->isFileExist(path);
+#endif
     }
 
-    LevelConfig* config = new LevelConfig();
+    template <size_t N>
+    bool keyEquals(const char* str, rapidjson::SizeType length, const char (&name)[N])
+    {
+        return length == N - 1 && std::memcmp(str, name, N - 1) == 0;
+    }
 
-    // 解析主牌区卡牌
-    if (doc.HasMember("Playfield") && doc["Playfield"].IsArray())
+    /**
+     * @brief 关卡JSON的SAX处理器
+     * 边解析边把字段写入预分配的卡牌数组，不构建DOM树
+     * 读取规则与原来按DOM读取时一致：同名字段只取第一个，类型不符的字段忽略，
+     * ZOrder和IsFaceUp只对主牌区生效，Position需要同时有数值x和y
+     */
+    class LevelConfigReaderHandler
+        : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, LevelConfigReaderHandler>
     {
-        const rapidjson::Value& playfield = doc["Playfield"];
-        std::vector<CardConfigData> playfieldCards;
+    public:
+        LevelConfigReaderHandler()
+            : _scope(kScopeNone)
+            , _skipDepth(0)
+            , _field(kFieldNone)
+            , _rootFields(0)
+            , _cardFields(0)
+            , _positionFields(0)
+            , _cards(nullptr)
+            , _positionX(0.0f)
+            , _positionY(0.0f)
+            , _coinReward(0)
+        {
+        }
+
+        /**
+         * @brief 把解析结果移入关卡配置
+         * @param computeOcclusion 是否先计算主牌区遮挡关系
+         */
+        void moveTo(LevelConfig* config, bool computeOcclusion)
+        {
+            if (computeOcclusion)
+            {
+                CardOcclusionUtils::computeBlockedBy(_playfieldCards, CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+            }
+            config->setPlayfieldCards(std::move(_playfieldCards));
+            config->setStackCards(std::move(_stackCards));
+            config->setCoinReward(_coinReward);
+        }
+
+        /**
+         * @brief 获取已解析的卡牌总数
+         */
+        int getCardCount() const { return static_cast<int>(_playfieldCards.size() + _stackCards.size()); }
+
+        bool Null() { return endValue(); }
+        bool String(const char*, rapidjson::SizeType, bool) { return endValue(); }
+
+        bool Bool(bool value)
+        {
+            if (_skipDepth == 0 && _field == kFieldIsFaceUp)
+            {
+                _cards->back().isFaceUp = value;
+            }
+            return endValue();
+        }
+
+        // 与rapidjson::Value::IsInt一致：能用int表示的整数才算int，所有数值都可以取float
+        bool Int(int value) { return number(true, value, static_cast<float>(value)); }
+        bool Uint(unsigned value)
+        {
+            return number(value <= static_cast<unsigned>(INT_MAX), static_cast<int>(value), static_cast<float>(value));
+        }
+        bool Int64(int64_t value) { return number(false, 0, static_cast<float>(static_cast<double>(value))); }
+        bool Uint64(uint64_t value) { return number(false, 0, static_cast<float>(static_cast<double>(value))); }
+        bool Double(double value) { return number(false, 0, static_cast<float>(value)); }
+
+        bool Key(const char* str, rapidjson::SizeType length, bool)
+        {
+            if (_skipDepth > 0) return true;
 
-        for (rapidjson::SizeType i = 0; i < playfield.Size(); i++)
+            Field field = kFieldNone;
+            unsigned* seenFields = nullptr;
+            switch (_scope)
+            {
+            case kScopeRoot:
+                if (keyEquals(str, length, "Playfield")) field = kFieldPlayfield;
+                else if (keyEquals(str, length, "Stack")) field = kFieldStack;
+                else if (keyEquals(str, length, "CoinReward")) field = kFieldCoinReward;
+                seenFields = &_rootFields;
+                break;
+            case kScopeCard:
+                if (keyEquals(str, length, "CardFace")) field = kFieldCardFace;
+                else if (keyEquals(str, length, "CardSuit")) field = kFieldCardSuit;
+                else if (keyEquals(str, length, "Position")) field = kFieldPosition;
+                else if (_cards != &_playfieldCards) field = kFieldNone;
+                else if (keyEquals(str, length, "ZOrder")) field = kFieldZOrder;
+                else if (keyEquals(str, length, "IsFaceUp")) field = kFieldIsFaceUp;
+                seenFields = &_cardFields;
+                break;
+            case kScopePosition:
+                if (keyEquals(str, length, "x")) field = kFieldX;
+                else if (keyEquals(str, length, "y")) field = kFieldY;
+                seenFields = &_positionFields;
+                break;
+            default:
+                break;
+            }
+
+            // 同名字段只有第一个生效
+            const unsigned bit = 1u << field;
+            if (field != kFieldNone && (*seenFields & bit) == 0)
+            {
+                *seenFields |= bit;
+                _field = field;
+            }
+            else
+            {
+                _field = kFieldNone;
+            }
+            return true;
+        }
+
+        bool StartObject()
         {
-            const rapidjson::Value& card = playfield[i];
-            CardConfigData data;
+            if (_skipDepth > 0)
+            {
+                _skipDepth++;
+                return true;
+            }
 
-            if (card.HasMember("CardFace") && card["CardFace"].IsInt())
-                data.cardFace = card["CardFace"].GetInt();
+            if (_scope == kScopeNone)
+            {
+                _scope = kScopeRoot;
+            }
+            else if (_scope == kScopeCardArray)
+            {
+                _cards->emplace_back();
+                _cardFields = 0;
+                _scope = kScopeCard;
+            }
+            else if (_scope == kScopeCard && _field == kFieldPosition)
+            {
+                _positionFields = 0;
+                _scope = kScopePosition;
+            }
+            else
+            {
+                _skipDepth = 1;
+            }
+            _field = kFieldNone;
+            return true;
+        }
 
-            if (card.HasMember("CardSuit") && card["CardSuit"].IsInt())
-                data.cardSuit = card["CardSuit"].GetInt();
+        bool EndObject(rapidjson::SizeType)
+        {
+            if (_skipDepth > 0)
+            {
+                _skipDepth--;
+                return endValue();
+            }
 
-            if (card.HasMember("Position") && card["Position"].IsObject())
+            if (_scope == kScopePosition)
             {
-                const rapidjson::Value& pos = card["Position"];
-                if (pos.HasMember("x") && pos.HasMember("y"))
+                if ((_positionFields & kPositionComplete) == kPositionComplete)
                 {
-                    data.position.x = pos["x"].GetFloat();
-                    data.position.y = pos["y"].GetFloat();
+                    _cards->back().position = Vec2f(_positionX, _positionY);
                 }
+                _scope = kScopeCard;
             }
+            else if (_scope == kScopeCard)
+            {
+                _scope = kScopeCardArray;
+            }
+            else if (_scope == kScopeRoot)
+            {
+                _scope = kScopeDone;
+            }
+            return endValue();
+        }
 
-            if (card.HasMember("ZOrder") && card["ZOrder"].IsInt())
-                data.zOrder = card["ZOrder"].GetInt();
-
-            if (card.HasMember("IsFaceUp") && card["IsFaceUp"].IsBool())
-                data.isFaceUp = card["IsFaceUp"].GetBool();
+        bool StartArray()
+        {
+            if (_skipDepth > 0)
+            {
+                _skipDepth++;
+                return true;
+            }
 
-            playfieldCards.push_back(data);
+            if (_scope == kScopeRoot && (_field == kFieldPlayfield || _field == kFieldStack))
+            {
+                // 不预先扫描文本统计卡牌数，数组随解析按倍数增长，起始容量跳过最初几次小的扩容
+                _cards = _field == kFieldPlayfield ? &_playfieldCards : &_stackCards;
+                _cards->reserve(kInitialCardCapacity);
+                _scope = kScopeCardArray;
+            }
+            else
+            {
+                _skipDepth = 1;
+            }
+            _field = kFieldNone;
+            return true;
         }
 
-        config->setPlayfieldCards(playfieldCards);
-    }
+        bool EndArray(rapidjson::SizeType)
+        {
+            if (_skipDepth > 0)
+            {
+                _skipDepth--;
+                return endValue();
+            }
 
-    // 解析备用牌堆
-    if (doc.HasMember("Stack") && doc["Stack"].IsArray())
-    {
-        const rapidjson::Value& stack = doc["Stack"];
-        std::vector<CardConfigData> stackCards;
+            if (_scope == kScopeCardArray)
+            {
+                _scope = kScopeRoot;
+            }
+            return endValue();
+        }
 
-        for (rapidjson::SizeType i = 0; i < stack.Size(); i++)
+    private:
+        enum Scope
         {
-            const rapidjson::Value& card = stack[i];
-            CardConfigData data;
+            kScopeNone,         // 还未进入根对象，或根不是对象
+            kScopeRoot,         // 根对象
+            kScopeCardArray,    // Playfield或Stack数组
+            kScopeCard,         // 卡牌对象
+            kScopePosition,     // 卡牌的Position对象
+            kScopeDone          // 根对象已结束
+        };
 
-            if (card.HasMember("CardFace") && card["CardFace"].IsInt())
-                data.cardFace = card["CardFace"].GetInt();
+        enum Field
+        {
+            kFieldNone,
+            kFieldPlayfield,
+            kFieldStack,
+            kFieldCoinReward,
+            kFieldCardFace,
+            kFieldCardSuit,
+            kFieldPosition,
+            kFieldZOrder,
+            kFieldIsFaceUp,
+            kFieldX,
+            kFieldY,
+            kFieldValidX,       // x是数值
+            kFieldValidY        // y是数值
+        };
+
+        static const unsigned kPositionComplete = (1u << kFieldValidX) | (1u << kFieldValidY);
+        static const size_t kInitialCardCapacity = 64;
+
+        bool endValue()
+        {
+            _field = kFieldNone;
+            return true;
+        }
 
-            if (card.HasMember("CardSuit") && card["CardSuit"].IsInt())
-                data.cardSuit = card["CardSuit"].GetInt();
+        bool number(bool isInt, int intValue, float floatValue)
+        {
+            if (_skipDepth > 0) return true;
 
-            if (card.HasMember("Position") && card["Position"].IsObject())
+            switch (_field)
             {
-                const rapidjson::Value& pos = card["Position"];
-                if (pos.HasMember("x") && pos.HasMember("y"))
-                {
-                    data.position.x = pos["x"].GetFloat();
-                    data.position.y = pos["y"].GetFloat();
-                }
+            case kFieldCoinReward:
+                if (isInt) _coinReward = intValue;
+                break;
+            case kFieldCardFace:
+                if (isInt) _cards->back().cardFace = intValue;
+                break;
+            case kFieldCardSuit:
+                if (isInt) _cards->back().cardSuit = intValue;
+                break;
+            case kFieldZOrder:
+                if (isInt) _cards->back().zOrder = intValue;
+                break;
+            case kFieldX:
+                _positionX = floatValue;
+                _positionFields |= 1u << kFieldValidX;
+                break;
+            case kFieldY:
+                _positionY = floatValue;
+                _positionFields |= 1u << kFieldValidY;
+                break;
+            default:
+                break;
             }
+            return endValue();
+        }
+
+    private:
+        Scope _scope;                               // 当前所在的层级
+        int _skipDepth;                             // 正在跳过的嵌套层数，大于0时忽略所有事件
+        Field _field;                               // 当前键对应的字段，读到值后复位
+        unsigned _rootFields;                       // 根对象中已出现的字段
+        unsigned _cardFields;                       // 当前卡牌中已出现的字段
+        unsigned _positionFields;                   // 当前Position中已出现的字段
+
+        std::vector<CardConfigData> _playfieldCards;
+        std::vector<CardConfigData> _stackCards;
+        std::vector<CardConfigData>* _cards;        // 正在解析的卡牌数组
+        float _positionX;
+        float _positionY;
+        int _coinReward;
+    };
+
+    /**
+     * @brief 用SAX处理器解析关卡JSON
+     * @param stream rapidjson输入流，原地解析时为InsituStringStream
+     * @param computeOcclusion 是否计算主牌区遮挡关系
+     * @return 关卡配置对象指针，失败返回nullptr
+     */
+    template <unsigned parseFlags, typename Stream>
+    LevelConfig* parseLevelConfigStream(Stream& stream, bool computeOcclusion)
+    {
+        LevelConfigReaderHandler handler;
+
+        rapidjson::Reader reader;
+        if (!reader.Parse<parseFlags>(stream, handler))
+        {
+            GAME_LOG("Failed to parse level config JSON");
+            return nullptr;
+        }
 
-            stackCards.push_back(data);
+        // 卡牌ID和槽位须能存入撤销记录
+        const int cardCount = handler.getCardCount();
+        if (cardCount > kLevelMaxCardCount)
+        {
+            GAME_LOG("Level config has %d cards, at most %d are supported", cardCount, kLevelMaxCardCount);
+            return nullptr;
         }
 
-        config->setStackCards(stackCards);
+        LevelConfig* config = new LevelConfig();
+        handler.moveTo(config, computeOcclusion);
+        return config;
     }
+}
 
-    // 解析关卡奖励金币
-    if (doc.HasMember("CoinReward") && doc["CoinReward"].IsInt())
+LevelConfig* LevelConfigLoader::loadLevelConfig(int levelId)
+{
+    std::string content = readLevelConfigFile(levelId);
+    if (content.empty()) return nullptr;
+
+    return parseLevelConfigInPlace(content);
+}
+
+std::string LevelConfigLoader::readLevelConfigFile(int levelId)
+{
+    GAME_TRACE_SCOPE_VALUE("readLevelConfigFile", levelId);
+    std::string path = getLevelConfigPath(levelId);
+    std::string content = readLevelFile(path);
+
+    if (content.empty())
     {
-        config->setCoinReward(doc["CoinReward"].GetInt());
+        GAME_LOG("Failed to load level config: %s", path.c_str());
     }
+    return content;
+}
 
-    return config;
+LevelConfig* LevelConfigLoader::parseLevelConfig(const std::string& jsonStr, bool computeOcclusion)
+{
+    GAME_TRACE_SCOPE_VALUE("parseLevelConfig", jsonStr.size());
+    // 直接从只读字符串解析，不复制输入
+    rapidjson::StringStream stream(jsonStr.c_str());
+    return parseLevelConfigStream<rapidjson::kParseDefaultFlags>(stream, computeOcclusion);
+}
+
+LevelConfig* LevelConfigLoader::parseLevelConfigInPlace(std::string& jsonStr, bool computeOcclusion)
+{
+    GAME_TRACE_SCOPE_VALUE("parseLevelConfig", jsonStr.size());
+    rapidjson::InsituStringStream stream(&jsonStr[0]);
+    return parseLevelConfigStream<rapidjson::kParseInsituFlag>(stream, computeOcclusion);
+}
+
+std::string LevelConfigLoader::serializeLevelConfig(const LevelConfig* levelConfig)
+{
+    if (!levelConfig) return "";
+
+    auto appendCards = [](std::string& json, const std::vector<CardConfigData>& cards, bool isPlayfield) {
+        char buffer[256];
+        for (size_t i = 0; i < cards.size(); i++)
+        {
+            const CardConfigData& data = cards[i];
+            snprintf(buffer, sizeof(buffer),
+                     "        {\n"
+                     "            \"CardFace\": %d,\n"
+                     "            \"CardSuit\": %d,\n"
+                     "            \"Position\": {\"x\": %g, \"y\": %g}",
+                     data.cardFace, data.cardSuit, data.position.x, data.position.y);
+            json += buffer;
+
+            // 层级和翻开状态只对主牌区有意义，取默认值时省略
+            if (isPlayfield && data.zOrder != 0)
+            {
+                snprintf(buffer, sizeof(buffer), ",\n            \"ZOrder\": %d", data.zOrder);
+                json += buffer;
+            }
+            if (isPlayfield && !data.isFaceUp)
+            {
+                json += ",\n            \"IsFaceUp\": false";
+            }
+            json += i + 1 < cards.size() ? "\n        },\n" : "\n        }\n";
+        }
+    };
+
+    std::string json = "{\n    \"Playfield\": [\n";
+    appendCards(json, levelConfig->getPlayfieldCards(), true);
+    json += "    ],\n    \"Stack\": [\n";
+    appendCards(json, levelConfig->getStackCards(), false);
+    json += "    ]";
+
+    if (levelConfig->getCoinReward() != 0)
+    {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), ",\n    \"CoinReward\": %d", levelConfig->getCoinReward());
+        json += buffer;
+    }
+    json += "\n}\n";
+    return json;
 }
 
 bool LevelConfigLoader::levelExists(int levelId)
 {
-    std::string path = getLevelConfigPath(levelId);
-    return FileUtils::getInstance()->isFileExist(path);
+    // 与LevelPrefetchManager::loadGameModel的查找顺序一致：关卡包、单独的编译关卡文件、关卡JSON，
+    // 关卡包之后新加的关卡也能被预加载；发布的关卡都在关卡包中，通常只查索引
+    if (LevelPackLoader::hasLevel(levelId)) return true;
+    if (levelFileExists(CompiledLevelLoader::getCompiledLevelPath(levelId))) return true;
+    return levelConfigFileExists(levelId);
+}
+
+bool LevelConfigLoader::levelConfigFileExists(int levelId)
+{
+    return levelFileExists(getLevelConfigPath(levelId));
 }
 
 std::string LevelConfigLoader::getLevelConfigPath(int levelId)
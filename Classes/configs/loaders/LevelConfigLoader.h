@@ -18,20 +18,54 @@ public:
      */
     static LevelConfig* loadLevelConfig(int levelId);
 
+    /**
+     * @brief 读取关卡配置文件的内容，不解析
+     * @param levelId 关卡ID
+     * @return 文件内容，失败返回空字符串
+     */
+    static std::string readLevelConfigFile(int levelId);
+
     /**
      * @brief 从JSON字符串解析关卡配置
+     * 以SAX方式直接解析到卡牌数组，不修改也不复制输入
+     * @param jsonStr JSON字符串
+     * @param computeOcclusion 是否计算主牌区遮挡关系；为false时blockedBy为空，供之后自行计算遮挡的调用方使用
+     * @return 关卡配置对象指针，失败返回nullptr
+     */
+    static LevelConfig* parseLevelConfig(const std::string& jsonStr, bool computeOcclusion = true);
+
+    /**
+     * @brief 从JSON字符串原地解析关卡配置
+     * 以SAX方式直接解析到卡牌数组，字符串内容会被改写，调用后不应再使用
      * @param jsonStr JSON字符串
+     * @param computeOcclusion 是否计算主牌区遮挡关系，同parseLevelConfig
      * @return 关卡配置对象指针，失败返回nullptr
      */
-    static LevelConfig* parseLevelConfig(const std::string& jsonStr);
+    static LevelConfig* parseLevelConfigInPlace(std::string& jsonStr, bool computeOcclusion = true);
+
+    /**
+     * @brief 将关卡配置序列化为JSON字符串
+     * 格式与关卡文件相同，可由parseLevelConfig读回；遮挡关系不写入，加载时重新计算
+     * @param levelConfig 关卡配置对象
+     * @return JSON字符串
+     */
+    static std::string serializeLevelConfig(const LevelConfig* levelConfig);
 
     /**
-     * @brief 检查关卡配置文件是否存在
+     * @brief 检查关卡是否存在
+     * 依次检查关卡包的索引、编译后的关卡文件和关卡配置文件，与加载时的查找顺序一致
      * @param levelId 关卡ID
      * @return 存在返回true，否则返回false
      */
     static bool levelExists(int levelId);
 
+    /**
+     * @brief 检查关卡配置文件（JSON）是否存在，不读取内容
+     * @param levelId 关卡ID
+     * @return 存在返回true
+     */
+    static bool levelConfigFileExists(int levelId);
+
 private:
     /**
      * @brief 获取关卡配置文件路径
@@ -0,0 +1,128 @@
+#include "LevelPackLoader.h"
+#include "../../utils/Lz4Codec.h"
+#include "../../utils/TraceUtils.h"
+#include <cstring>
+#include <vector>
+
+#ifndef GAME_CORE_HEADLESS
+#include "cocos2d.h"
+#endif
+
+namespace
+{
+    /**
+     * @brief 打开关卡包文件
+     * 资源在普通文件中时直接映射，在安装包内（Android）时由FileUtils读出后加载
+     */
+    bool openLevelPack(LevelPack& levelPack)
+    {
+        const std::string path = LevelPackLoader::getLevelPackPath();
+#ifdef GAME_CORE_HEADLESS
+        return levelPack.open(path);
+#else
+        auto fileUtils = cocos2d::FileUtils::getInstance();
+        const std::string fullPath = fileUtils->fullPathForFilename(path);
+        if (fullPath.empty()) return false;
+        if (levelPack.open(fullPath)) return true;
+
+        cocos2d::Data data = fileUtils->getDataFromFile(fullPath);
+        return !data.isNull() && levelPack.openFromMemory(data.getBytes(), static_cast<size_t>(data.getSize()));
+#endif
+    }
+
+    /**
+     * @brief 按8字节对齐追加一段数据，返回该段的偏移
+     */
+    uint64_t appendSection(std::string& data, const void* section, size_t size)
+    {
+        data.resize((data.size() + 7) & ~static_cast<size_t>(7), '\0');
+        const uint64_t offset = data.size();
+        if (size > 0) data.append(static_cast<const char*>(section), size);
+        return offset;
+    }
+}
+
+const LevelPack* LevelPackLoader::getLevelPack()
+{
+    // 局部静态变量的初始化是线程安全的，关卡包在整个运行期间只打开一次
+    static LevelPack levelPack;
+    static const bool opened = openLevelPack(levelPack);
+    return opened ? &levelPack : nullptr;
+}
+
+bool LevelPackLoader::loadLevel(int levelId, CompiledLevel& outLevel)
+{
+    GAME_TRACE_SCOPE_VALUE("loadPackLevel", levelId);
+    const LevelPack* levelPack = getLevelPack();
+    return levelPack && levelPack->loadLevel(levelId, outLevel);
+}
+
+bool LevelPackLoader::hasLevel(int levelId)
+{
+    const LevelPack* levelPack = getLevelPack();
+    return levelPack && levelPack->hasLevel(levelId);
+}
+
+std::string LevelPackLoader::buildLevelPack(const std::map<int, std::string>& compiledLevels, bool compress)
+{
+    // 文件头和索引按本机内存布局写出，只能在小端序的机器上生成
+    if (!CompiledLevel::isHostLittleEndian()) return "";
+
+    std::vector<LevelPackEntry> entries;
+    entries.reserve(compiledLevels.size());
+
+    // 先写文件头和索引占位，关卡数据依次追加在后面
+    const size_t indexOffset = (sizeof(LevelPackHeader) + 7) & ~static_cast<size_t>(7);
+    std::string data(indexOffset + compiledLevels.size() * sizeof(LevelPackEntry), '\0');
+
+    for (const auto& level : compiledLevels)
+    {
+        const std::string& raw = level.second;
+        if (raw.empty() || raw.size() > UINT32_MAX) return "";
+
+        LevelPackEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.levelId = level.first;
+        entry.rawSize = static_cast<uint32_t>(raw.size());
+        entry.contentHash = LevelPack::computeContentHash(raw.data(), raw.size());
+
+        uint64_t offset;
+        std::string compressed = compress ? Lz4Codec::compress(raw.data(), raw.size()) : std::string();
+        if (compress && compressed.size() < raw.size())
+        {
+            entry.flags = kLevelPackEntryLz4;
+            entry.storedSize = static_cast<uint32_t>(compressed.size());
+            offset = appendSection(data, compressed.data(), compressed.size());
+        }
+        else
+        {
+            entry.storedSize = entry.rawSize;
+            offset = appendSection(data, raw.data(), raw.size());
+        }
+        if (data.size() > UINT32_MAX) return "";
+
+        entry.offset = static_cast<uint32_t>(offset);
+        entries.push_back(entry);
+    }
+
+    LevelPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kLevelPackMagic;
+    header.version = kLevelPackVersion;
+    header.headerSize = sizeof(LevelPackHeader);
+    header.fileSize = static_cast<uint32_t>(data.size());
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.indexOffset = static_cast<uint32_t>(indexOffset);
+
+    std::memcpy(&data[0], &header, sizeof(header));
+    if (!entries.empty())
+    {
+        std::memcpy(&data[indexOffset], entries.data(), entries.size() * sizeof(LevelPackEntry));
+    }
+    return data;
+}
+
+std::string LevelPackLoader::getLevelPackPath()
+{
+    return "levels/levels.pack";
+}
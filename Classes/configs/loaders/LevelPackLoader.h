@@ -0,0 +1,54 @@
+#ifndef __LEVEL_PACK_LOADER_H__
+#define __LEVEL_PACK_LOADER_H__
+
+#include "../models/CompiledLevel.h"
+#include "../models/LevelPack.h"
+#include <map>
+#include <string>
+
+/**
+ * @brief 关卡包的加载器和打包器
+ * 全部关卡由level_pack_builder工具打包为levels/levels.pack，游戏运行期间只打开一次，
+ * 关卡是否存在通过索引判断，加载关卡时只解码请求的那一关
+ */
+class LevelPackLoader
+{
+public:
+    /**
+     * @brief 获取关卡包
+     * 第一次调用时打开并校验关卡包，之后返回同一个对象，可在多个线程中调用
+     * @return 关卡包，没有关卡包或关卡包无效时返回nullptr
+     */
+    static const LevelPack* getLevelPack();
+
+    /**
+     * @brief 从关卡包加载关卡
+     * @param levelId 关卡ID
+     * @param outLevel 输出参数，成功时持有该关卡的数据
+     * @return 成功返回true，没有关卡包、关卡不在包中或数据损坏时返回false
+     */
+    static bool loadLevel(int levelId, CompiledLevel& outLevel);
+
+    /**
+     * @brief 检查关卡包中是否有该关卡（只查索引，不访问文件系统）
+     * @param levelId 关卡ID
+     * @return 存在返回true，没有关卡包时返回false
+     */
+    static bool hasLevel(int levelId);
+
+    /**
+     * @brief 把编译后的关卡打包
+     * @param compiledLevels 关卡ID到编译后关卡数据（见CompiledLevelLoader::compileLevelConfig）的映射
+     * @param compress 是否用LZ4压缩，压缩后不能变小的关卡仍按原样存放
+     * @return 关卡包文件内容，有关卡数据为空、总大小超过4GB或本机为大端序时返回空字符串
+     */
+    static std::string buildLevelPack(const std::map<int, std::string>& compiledLevels, bool compress);
+
+    /**
+     * @brief 获取关卡包文件的路径
+     * @return 文件路径
+     */
+    static std::string getLevelPackPath();
+};
+
+#endif // __LEVEL_PACK_LOADER_H__
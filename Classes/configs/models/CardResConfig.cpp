@@ -1,4 +1,33 @@
 #include "CardResConfig.h"
+#include <cstdio>
+
+const float CardResConfig::kCardWidth = 120.0f;
+const float CardResConfig::kCardHeight = 160.0f;
+
+const CardPartLayout CardResConfig::kBackLayout = {kCardWidth / 2, kCardHeight / 2, 1.0f};
+const CardPartLayout CardResConfig::kBigNumberLayout = {kCardWidth / 2, kCardHeight / 2 - 20, 1.0f};
+const CardPartLayout CardResConfig::kSmallNumberLayout = {15.0f, kCardHeight - 5, 0.8f};
+const CardPartLayout CardResConfig::kSuitLayout = {kCardWidth - 15, kCardHeight - 5, 0.6f};
+
+namespace
+{
+    const char* kSuitNames[] = {"club", "diamond", "heart", "spade"};
+    const char* kFaceNames[] = {"A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
+}
+
+std::string CardResConfig::getCardAtlasPath()
+{
+    return "res/card_atlas.plist";
+}
+
+std::string CardResConfig::getCardFaceFrameName(int face, int suit)
+{
+    if (face < 0 || face > 12 || suit < 0 || suit > 3) return "";
+
+    char name[128];
+    sprintf(name, "card_face/%s_%s.png", kSuitNames[suit], kFaceNames[face]);
+    return name;
+}
 
 std::string CardResConfig::getCardBackPath()
 {
@@ -7,7 +36,6 @@ std::string CardResConfig::getCardBackPath()
 
 std::string CardResConfig::getCardSuitPath(int suit)
 {
-    static const char* kSuitNames[] = {"club", "diamond", "heart", "spade"};
     if (suit < 0 || suit > 3) return "";
 
     char path[128];
@@ -17,7 +45,6 @@ std::string CardResConfig::getCardSuitPath(int suit)
 
 std::string CardResConfig::getCardBigNumberPath(int face, bool isRed)
 {
-    static const char* kFaceNames[] = {"A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
     if (face < 0 || face > 12) return "";
 
     const char* color = isRed ? "red" : "black";
@@ -28,7 +55,6 @@ std::string CardResConfig::getCardBigNumberPath(int face, bool isRed)
 
 std::string CardResConfig::getCardSmallNumberPath(int face, bool isRed)
 {
-    static const char* kFaceNames[] = {"A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
     if (face < 0 || face > 12) return "";
 
     const char* color = isRed ? "red" : "black";
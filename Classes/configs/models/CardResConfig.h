@@ -3,13 +3,49 @@
 
 #include <string>
 
+/**
+ * @brief 卡牌部件在卡牌节点内的摆放
+ * 坐标为部件中心点在卡牌节点内的位置（左下角为原点，y轴向上）
+ */
+struct CardPartLayout
+{
+    float x;
+    float y;
+    float scale;
+};
+
 /**
  * @brief 卡牌资源配置类
  * 负责管理卡牌显示所需的图片资源路径
+ * 各部件图片都打包在卡牌图集中，图集的帧名与图片路径相同，下面的路径同时用作帧名
  */
 class CardResConfig
 {
 public:
+    static const float kCardWidth;      // 卡牌宽度（也是点击和遮挡判定的范围）
+    static const float kCardHeight;     // 卡牌高度
+
+    static const CardPartLayout kBackLayout;            // 卡牌底图，合成的牌面与底图大小、位置相同
+    static const CardPartLayout kBigNumberLayout;       // 大数字（中间偏下）
+    static const CardPartLayout kSmallNumberLayout;     // 小数字（左上角）
+    static const CardPartLayout kSuitLayout;            // 花色图标（右上角）
+
+    /**
+     * @brief 获取卡牌图集配置文件路径
+     * 图集由tools/card_atlas_builder从各部件图片生成
+     * @return 图集plist文件的资源路径
+     */
+    static std::string getCardAtlasPath();
+
+    /**
+     * @brief 获取合成牌面在卡牌图集中的帧名
+     * 合成牌面由card_atlas_builder按上面的部件摆放预先绘制，每张牌只需一个精灵
+     * @param face 牌面数字 (0-A, 1-2, ..., 12-K)
+     * @param suit 花色类型 (0-梅花, 1-方块, 2-红桃, 3-黑桃)
+     * @return 帧名，参数无效时返回空字符串
+     */
+    static std::string getCardFaceFrameName(int face, int suit);
+
     /**
      * @brief 获取卡牌背面图片路径
      * @return 卡牌背面图片的资源路径
@@ -0,0 +1,100 @@
+#include "CompiledLevel.h"
+#include "LevelConfig.h"
+#include <type_traits>
+
+static_assert(sizeof(CompiledLevelHeader) == 48, "CompiledLevelHeader layout is part of the file format");
+static_assert(sizeof(CompiledCardData) == 28, "CompiledCardData layout is part of the file format");
+static_assert(std::is_trivially_copyable<CompiledCardData>::value, "CompiledCardData must be trivially copyable");
+
+namespace
+{
+    /**
+     * @brief 检查[offset, offset + count * elementSize)是否在文件内且按元素对齐
+     */
+    bool isSectionValid(uint32_t offset, uint32_t count, size_t elementSize, size_t alignment, size_t fileSize)
+    {
+        if (offset % alignment != 0) return false;
+        if (offset > fileSize) return false;
+        return static_cast<uint64_t>(count) * elementSize <= fileSize - offset;
+    }
+}
+
+CompiledLevel::CompiledLevel()
+    : _header(nullptr)
+    , _playfieldCards(nullptr)
+    , _stackCards(nullptr)
+    , _blockers(nullptr)
+{
+}
+
+CompiledLevel::~CompiledLevel()
+{
+}
+
+bool CompiledLevel::open(const std::string& path)
+{
+    _header = nullptr;
+    return _file.open(path) && attach();
+}
+
+bool CompiledLevel::openFromMemory(const void* data, size_t size)
+{
+    _header = nullptr;
+    return _file.assign(data, size) && attach();
+}
+
+bool CompiledLevel::attach()
+{
+    const uint8_t* data = _file.getData();
+    const size_t size = _file.getSize();
+
+    const CompiledLevelHeader* header = reinterpret_cast<const CompiledLevelHeader*>(data);
+    bool valid = isHostLittleEndian()
+              && size >= sizeof(CompiledLevelHeader)
+              && header->magic == kCompiledLevelMagic
+              && header->version == kCompiledLevelVersion
+              && header->headerSize == sizeof(CompiledLevelHeader)
+              && header->fileSize == size
+              && static_cast<uint64_t>(header->playfieldCount) + header->stackCount <= static_cast<uint64_t>(kLevelMaxCardCount)
+              && isSectionValid(header->playfieldOffset, header->playfieldCount, sizeof(CompiledCardData), 4, size)
+              && isSectionValid(header->stackOffset, header->stackCount, sizeof(CompiledCardData), 4, size)
+              && isSectionValid(header->blockerOffset, header->blockerCount, sizeof(uint16_t), 2, size);
+
+    if (valid)
+    {
+        _playfieldCards = reinterpret_cast<const CompiledCardData*>(data + header->playfieldOffset);
+        _stackCards = reinterpret_cast<const CompiledCardData*>(data + header->stackOffset);
+        _blockers = reinterpret_cast<const uint16_t*>(data + header->blockerOffset);
+
+        // 遮挡者下标只在加载时检查一次，之后按下标访问不再检查
+        for (uint32_t i = 0; valid && i < header->playfieldCount; i++)
+        {
+            const CompiledCardData& card = _playfieldCards[i];
+            if (static_cast<uint64_t>(card.blockerBegin) + card.blockerCount > header->blockerCount)
+            {
+                valid = false;
+                break;
+            }
+            for (uint16_t j = 0; j < card.blockerCount; j++)
+            {
+                if (_blockers[card.blockerBegin + j] >= header->playfieldCount)
+                {
+                    valid = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!valid)
+    {
+        _file.close();
+        _playfieldCards = nullptr;
+        _stackCards = nullptr;
+        _blockers = nullptr;
+        return false;
+    }
+
+    _header = header;
+    return true;
+}
@@ -0,0 +1,142 @@
+#ifndef __COMPILED_LEVEL_H__
+#define __COMPILED_LEVEL_H__
+
+#include "../../utils/MappedFile.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 编译后关卡文件的文件头
+ * 文件为小端序，映射后按本机内存布局直接使用，大端序的机器上拒绝加载和生成（见CompiledLevel::isHostLittleEndian）
+ * 各段的偏移都相对文件开头并按8字节对齐：
+ * 文件头 | 主牌区卡牌数组 | 备用牌堆卡牌数组 | 遮挡者下标数组
+ */
+struct CompiledLevelHeader
+{
+    uint32_t magic;             // 固定为kCompiledLevelMagic
+    uint16_t version;           // 格式版本，与kCompiledLevelVersion不同时拒绝加载
+    uint16_t headerSize;        // 文件头字节数
+    uint32_t fileSize;          // 文件总字节数
+    int32_t coinReward;         // 通关奖励金币
+    uint32_t playfieldCount;    // 主牌区卡牌数量
+    uint32_t playfieldOffset;   // 主牌区卡牌数组的偏移
+    uint32_t stackCount;        // 备用牌堆卡牌数量
+    uint32_t stackOffset;       // 备用牌堆卡牌数组的偏移
+    uint32_t blockerCount;      // 遮挡者下标总数
+    uint32_t blockerOffset;     // 遮挡者下标数组的偏移
+    uint64_t sourceHash;        // 编译时关卡JSON内容的哈希（见LevelPack::computeContentHash），0表示未记录
+};
+
+/**
+ * @brief 编译后关卡文件中的一张卡牌
+ * 与CardConfigData对应，遮挡关系和绘制层级在编译时算好，加载时直接使用
+ */
+struct CompiledCardData
+{
+    float positionX;            // 卡牌位置
+    float positionY;
+    int32_t zOrder;             // 配置中的层级
+    int32_t drawRank;           // 唯一的绘制层级（见CardOcclusionUtils::computeDrawRanks），备用牌为0
+    uint32_t blockerBegin;      // 遮挡者在遮挡者下标数组中的起始位置
+    uint16_t blockerCount;      // 遮挡者数量
+    uint8_t cardFace;           // 牌面点数
+    uint8_t cardSuit;           // 花色
+    uint8_t isFaceUp;           // 是否翻开
+    uint8_t reserved[3];        // 保留，写0
+};
+
+static const uint32_t kCompiledLevelMagic = 0x564C4B50;    // "PKLV"
+static const uint16_t kCompiledLevelVersion = 2;
+
+/**
+ * @brief 编译后的关卡
+ * 映射整个关卡文件，卡牌数组直接指向文件内容，加载时不解析也不逐张分配
+ * 对象持有映射，指针在对象销毁或重新打开前有效
+ */
+class CompiledLevel
+{
+public:
+    CompiledLevel();
+    ~CompiledLevel();
+
+    /**
+     * @brief 映射并校验关卡文件
+     * @param path 文件路径
+     * @return 成功返回true，文件不存在、版本不符或内容损坏时返回false
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 从内存加载并校验关卡数据（数据会被复制一份）
+     * @param data 数据指针
+     * @param size 数据字节数
+     * @return 成功返回true
+     */
+    bool openFromMemory(const void* data, size_t size);
+
+    /**
+     * @brief 判断是否已成功加载
+     */
+    bool isValid() const { return _header != nullptr; }
+
+    /**
+     * @brief 获取主牌区卡牌数量/数组
+     */
+    int getPlayfieldCount() const { return static_cast<int>(_header->playfieldCount); }
+    const CompiledCardData* getPlayfieldCards() const { return _playfieldCards; }
+
+    /**
+     * @brief 获取备用牌堆卡牌数量/数组，第一张为初始底牌
+     */
+    int getStackCount() const { return static_cast<int>(_header->stackCount); }
+    const CompiledCardData* getStackCards() const { return _stackCards; }
+
+    /**
+     * @brief 获取主牌区卡牌的遮挡者下标（主牌区数组中的下标，升序）
+     * @param card 主牌区卡牌
+     * @return 下标数组，长度为card.blockerCount
+     */
+    const uint16_t* getBlockers(const CompiledCardData& card) const { return _blockers + card.blockerBegin; }
+
+    /**
+     * @brief 获取遮挡者下标的总数
+     */
+    int getBlockerCount() const { return static_cast<int>(_header->blockerCount); }
+
+    /**
+     * @brief 获取通关奖励金币
+     */
+    int getCoinReward() const { return _header->coinReward; }
+
+    /**
+     * @brief 获取编译时关卡JSON内容的哈希，0表示未记录
+     */
+    uint64_t getSourceHash() const { return _header->sourceHash; }
+
+    /**
+     * @brief 判断本机是否为小端序，关卡文件和关卡包只能在小端序的机器上原地使用
+     */
+    static bool isHostLittleEndian()
+    {
+        const uint16_t probe = 1;
+        return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+    }
+
+private:
+    CompiledLevel(const CompiledLevel&) = delete;
+    CompiledLevel& operator=(const CompiledLevel&) = delete;
+
+    /**
+     * @brief 校验映射的内容并设置各段指针，失败时关闭文件
+     */
+    bool attach();
+
+private:
+    MappedFile _file;                           // 关卡文件映射
+    const CompiledLevelHeader* _header;         // 文件头
+    const CompiledCardData* _playfieldCards;    // 主牌区卡牌数组
+    const CompiledCardData* _stackCards;        // 备用牌堆卡牌数组
+    const uint16_t* _blockers;                  // 遮挡者下标数组
+};
+
+#endif // __COMPILED_LEVEL_H__
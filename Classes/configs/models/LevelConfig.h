@@ -1,8 +1,11 @@
 #ifndef __LEVEL_CONFIG_H__
 #define __LEVEL_CONFIG_H__
 
+#include <utility>
 #include <vector>
-#include "cocos2d.h"
+#include "../../utils/Vec2f.h"
+
+static const int kLevelMaxCardCount = 0x8000;   // 一个关卡最多的卡牌数量（主牌区和备用牌堆合计），撤销记录用15位保存卡牌ID和槽位
 
 /**
  * @brief 关卡配置中的卡牌数据
@@ -12,7 +15,7 @@ struct CardConfigData
 {
     int cardFace;               // 牌面点数 (0-A, 1-2, ..., 12-K)
     int cardSuit;               // 花色 (0-梅花, 1-方块, 2-红桃, 3-黑桃)
-    cocos2d::Vec2 position;     // 卡牌位置
+    Vec2f position;             // 卡牌位置
     int zOrder;                 // Z轴层级(数值越大越在上层)
     std::vector<int> blockedBy; // 被哪些卡牌遮挡(存储卡牌索引)
     bool isFaceUp;              // 是否翻开显示(true:翻开, false:背面)
@@ -47,12 +50,14 @@ public:
      * @param cards 卡牌配置列表
      */
     void setPlayfieldCards(const std::vector<CardConfigData>& cards) { _playfieldCards = cards; }
+    void setPlayfieldCards(std::vector<CardConfigData>&& cards) { _playfieldCards = std::move(cards); }
 
     /**
      * @brief 设置备用牌堆的卡牌配置列表
      * @param cards 卡牌配置列表
      */
     void setStackCards(const std::vector<CardConfigData>& cards) { _stackCards = cards; }
+    void setStackCards(std::vector<CardConfigData>&& cards) { _stackCards = std::move(cards); }
 
     /**
      * @brief 获取/设置关卡奖励金币
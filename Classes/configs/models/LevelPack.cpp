@@ -0,0 +1,124 @@
+#include "LevelPack.h"
+#include "../../utils/Lz4Codec.h"
+#include <vector>
+
+static_assert(sizeof(LevelPackHeader) == 24, "LevelPackHeader layout is part of the file format");
+static_assert(sizeof(LevelPackEntry) == 32, "LevelPackEntry layout is part of the file format");
+
+LevelPack::LevelPack()
+    : _header(nullptr)
+    , _entries(nullptr)
+{
+}
+
+LevelPack::~LevelPack()
+{
+}
+
+bool LevelPack::open(const std::string& path)
+{
+    _header = nullptr;
+    return _file.open(path) && attach();
+}
+
+bool LevelPack::openFromMemory(const void* data, size_t size)
+{
+    _header = nullptr;
+    return _file.assign(data, size) && attach();
+}
+
+bool LevelPack::attach()
+{
+    const uint8_t* data = _file.getData();
+    const size_t size = _file.getSize();
+
+    const LevelPackHeader* header = reinterpret_cast<const LevelPackHeader*>(data);
+    bool valid = CompiledLevel::isHostLittleEndian()
+              && size >= sizeof(LevelPackHeader)
+              && header->magic == kLevelPackMagic
+              && header->version == kLevelPackVersion
+              && header->headerSize == sizeof(LevelPackHeader)
+              && header->fileSize == size
+              && header->indexOffset % 8 == 0
+              && header->indexOffset <= size
+              && static_cast<uint64_t>(header->entryCount) * sizeof(LevelPackEntry) <= size - header->indexOffset;
+
+    if (valid)
+    {
+        const LevelPackEntry* entries = reinterpret_cast<const LevelPackEntry*>(data + header->indexOffset);
+
+        // 索引在打开时检查一次：关卡ID严格升序，数据段在文件内，之后查找和解码不再检查范围
+        // 解压后的大小决定解码时分配的内存，限制在单关上限和LZ4能达到的压缩比以内，损坏的索引不会导致超大分配
+        for (uint32_t i = 0; valid && i < header->entryCount; i++)
+        {
+            const LevelPackEntry& entry = entries[i];
+            const bool compressed = (entry.flags & kLevelPackEntryLz4) != 0;
+            valid = (i == 0 || entries[i - 1].levelId < entry.levelId)
+                 && (entry.flags & ~kLevelPackEntryLz4) == 0
+                 && entry.offset % 8 == 0
+                 && entry.offset <= size
+                 && entry.storedSize <= size - entry.offset
+                 && entry.rawSize > 0
+                 && entry.rawSize <= kLevelPackMaxRawSize
+                 && (compressed ? static_cast<uint64_t>(entry.rawSize) <= static_cast<uint64_t>(entry.storedSize) * kLevelPackMaxLz4Ratio
+                                : entry.storedSize == entry.rawSize);
+        }
+
+        if (valid) _entries = entries;
+    }
+
+    if (!valid)
+    {
+        _file.close();
+        _entries = nullptr;
+        return false;
+    }
+
+    _header = header;
+    return true;
+}
+
+const LevelPackEntry* LevelPack::findEntry(int levelId) const
+{
+    if (!_header) return nullptr;
+
+    size_t low = 0;
+    size_t high = _header->entryCount;
+    while (low < high)
+    {
+        const size_t mid = (low + high) / 2;
+        if (_entries[mid].levelId < levelId) low = mid + 1;
+        else high = mid;
+    }
+    return low < _header->entryCount && _entries[low].levelId == levelId ? &_entries[low] : nullptr;
+}
+
+bool LevelPack::loadLevel(int levelId, CompiledLevel& outLevel) const
+{
+    const LevelPackEntry* entry = findEntry(levelId);
+    if (!entry) return false;
+
+    const uint8_t* stored = _file.getData() + entry->offset;
+    if ((entry->flags & kLevelPackEntryLz4) == 0)
+    {
+        return computeContentHash(stored, entry->rawSize) == entry->contentHash
+            && outLevel.openFromMemory(stored, entry->rawSize);
+    }
+
+    std::vector<uint8_t> raw(entry->rawSize);
+    return Lz4Codec::decompress(stored, entry->storedSize, raw.data(), raw.size())
+        && computeContentHash(raw.data(), raw.size()) == entry->contentHash
+        && outLevel.openFromMemory(raw.data(), raw.size());
+}
+
+uint64_t LevelPack::computeContentHash(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
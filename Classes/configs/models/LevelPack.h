@@ -0,0 +1,128 @@
+#ifndef __LEVEL_PACK_H__
+#define __LEVEL_PACK_H__
+
+#include "CompiledLevel.h"
+#include "../../utils/MappedFile.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 关卡包的文件头
+ * 关卡包把所有编译后的关卡（见CompiledLevel）放在一个文件中，文件为小端序：
+ * 文件头 | 索引（按关卡ID升序的LevelPackEntry数组） | 各关卡数据（按8字节对齐）
+ */
+struct LevelPackHeader
+{
+    uint32_t magic;             // 固定为kLevelPackMagic
+    uint16_t version;           // 格式版本，与kLevelPackVersion不同时拒绝加载
+    uint16_t headerSize;        // 文件头字节数
+    uint32_t fileSize;          // 文件总字节数
+    uint32_t entryCount;        // 关卡数量
+    uint32_t indexOffset;       // 索引的偏移
+    uint32_t reserved;          // 保留，写0
+};
+
+/**
+ * @brief 关卡包索引中的一项
+ */
+struct LevelPackEntry
+{
+    int32_t levelId;            // 关卡ID
+    uint32_t flags;             // 见kLevelPackEntryLz4
+    uint32_t offset;            // 关卡数据的偏移
+    uint32_t storedSize;        // 关卡数据在包中的字节数
+    uint32_t rawSize;           // 解压后的字节数，未压缩时与storedSize相同
+    uint32_t reserved;          // 保留，写0
+    uint64_t contentHash;       // 解压后内容的哈希（见LevelPack::computeContentHash），解码时校验
+};
+
+static const uint32_t kLevelPackMagic = 0x504C4B50;    // "PKLP"
+static const uint16_t kLevelPackVersion = 1;
+static const uint32_t kLevelPackEntryLz4 = 1;          // 关卡数据用LZ4块格式压缩
+static const uint32_t kLevelPackMaxRawSize = 4 << 20;  // 单个关卡解压后的字节数上限（4MB，约15万张卡牌）
+static const uint32_t kLevelPackMaxLz4Ratio = 255;     // LZ4块格式的最大压缩比，解压后不会超过压缩数据的255倍
+
+/**
+ * @brief 关卡包
+ * 映射整个关卡包文件，打开时只校验文件头和索引，关卡数据在请求时才解压和校验
+ * 对象持有映射，读取操作不修改对象，可在多个线程中同时解码不同关卡
+ */
+class LevelPack
+{
+public:
+    LevelPack();
+    ~LevelPack();
+
+    /**
+     * @brief 映射并校验关卡包文件
+     * @param path 文件路径
+     * @return 成功返回true，文件不存在、版本不符或索引损坏时返回false
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 从内存加载并校验关卡包（数据会被复制一份）
+     * @param data 数据指针
+     * @param size 数据字节数
+     * @return 成功返回true
+     */
+    bool openFromMemory(const void* data, size_t size);
+
+    /**
+     * @brief 判断是否已成功加载
+     */
+    bool isValid() const { return _header != nullptr; }
+
+    /**
+     * @brief 获取关卡数量/索引数组（按关卡ID升序）
+     */
+    int getLevelCount() const { return _header ? static_cast<int>(_header->entryCount) : 0; }
+    const LevelPackEntry* getEntries() const { return _entries; }
+
+    /**
+     * @brief 在索引中查找关卡（二分查找）
+     * @param levelId 关卡ID
+     * @return 索引项，不存在时返回nullptr
+     */
+    const LevelPackEntry* findEntry(int levelId) const;
+
+    /**
+     * @brief 检查关卡包中是否有该关卡
+     * @param levelId 关卡ID
+     * @return 存在返回true
+     */
+    bool hasLevel(int levelId) const { return findEntry(levelId) != nullptr; }
+
+    /**
+     * @brief 解码一个关卡
+     * 只解压和校验请求的关卡，其余关卡不会被读取
+     * @param levelId 关卡ID
+     * @param outLevel 输出参数，成功时持有该关卡数据的副本
+     * @return 成功返回true，关卡不存在或数据损坏时返回false
+     */
+    bool loadLevel(int levelId, CompiledLevel& outLevel) const;
+
+    /**
+     * @brief 计算关卡数据的内容哈希（FNV-1a）
+     * @param data 数据指针
+     * @param size 数据字节数
+     * @return 64位哈希
+     */
+    static uint64_t computeContentHash(const void* data, size_t size);
+
+private:
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    /**
+     * @brief 校验映射的文件头和索引，失败时关闭文件
+     */
+    bool attach();
+
+private:
+    MappedFile _file;                   // 关卡包文件映射
+    const LevelPackHeader* _header;     // 文件头
+    const LevelPackEntry* _entries;     // 索引数组
+};
+
+#endif // __LEVEL_PACK_H__
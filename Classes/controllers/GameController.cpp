@@ -4,23 +4,45 @@
 #include "../models/UndoModel.h"
 #include "../views/GameView.h"
 #include "../views/CardView.h"
-#include "../configs/models/LevelConfig.h"
+#include "../views/CardViewPool.h"
 #include "../configs/loaders/LevelConfigLoader.h"
-#include "../services/GameModelGenerator.h"
+#include "../managers/LevelPrefetchManager.h"
 #include "../managers/UndoManager.h"
 #include "../utils/CardMatchUtils.h"
+#include "../utils/CocosVecAdapter.h"
+#include "../utils/TraceUtils.h"
 
 USING_NS_CC;
 
+namespace
+{
+    const char* const kPrefetchPollKey = "GameController.prefetchPoll";
+}
+
 GameController::GameController()
     : _gameModel(nullptr)
     , _gameView(nullptr)
     , _undoManager(nullptr)
+    , _prefetchManager(new LevelPrefetchManager())
+    , _levelId(0)
 {
+    // 每帧把后台加载完成的关卡取回主线程，不等待后台线程
+    Director::getInstance()->getScheduler()->schedule([this](float) {
+        _prefetchManager->pollCompleted();
+    }, this, 0.0f, false, kPrefetchPollKey);
 }
 
 GameController::~GameController()
 {
+    Director::getInstance()->getScheduler()->unschedule(kPrefetchPollKey, this);
+
+    // 先停止后台加载线程
+    if (_prefetchManager)
+    {
+        delete _prefetchManager;
+        _prefetchManager = nullptr;
+    }
+
     if (_gameModel)
     {
         delete _gameModel;
@@ -36,47 +58,94 @@ GameController::~GameController()
 
 bool GameController::startGame(int levelId, Node* parentNode)
 {
-    // 加载关卡配置
-    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(levelId);
-    if (!levelConfig)
+    GAME_TRACE_SCOPE_VALUE("startGame", levelId);
+
+    if (levelId == _levelId && _gameModel && _gameModel->restoreSnapshot(_startSnapshot))
     {
-        CCLOG("Failed to load level config: %d", levelId);
-        return false;
+        // 重新开始当前关卡：恢复开局时的快照，数据模型不重新加载和生成，只重建视图
+        releaseGameView();
     }
-
-    // 初始化游戏数据
-    if (!initGameData(levelConfig))
+    else
     {
-        delete levelConfig;
-        return false;
+        // 下一关已在后台加载好时直接取用，还在加载时等它完成，否则同步加载
+        GameModel* gameModel = _prefetchManager->takeGameModel(levelId);
+        if (!gameModel)
+        {
+            gameModel = LevelPrefetchManager::loadGameModel(levelId);
+        }
+        if (!gameModel)
+        {
+            CCLOG("Failed to load level: %d", levelId);
+            return false;
+        }
+
+        releaseGame();
+        _gameModel = gameModel;
+        _levelId = levelId;
+        _startSnapshot = _gameModel->createSnapshot();
     }
 
-    delete levelConfig;
-
     // 初始化撤销管理器
-    _undoManager = new UndoManager();
+    if (_undoManager)
+    {
+        _undoManager->clear();
+    }
+    else
+    {
+        _undoManager = new UndoManager();
+    }
 
     // 初始化游戏视图
     initGameView(parentNode);
 
+    // 玩这一关的同时在后台准备下一关；重新开始时已准备好的下一关保留
+    _prefetchManager->retainLevels(levelId, levelId + 1);
+    if (LevelConfigLoader::levelExists(levelId + 1))
+    {
+        _prefetchManager->prefetch(levelId + 1);
+    }
+
     return true;
 }
 
-bool GameController::initGameData(const LevelConfig* levelConfig)
+bool GameController::startNextLevel(Node* parentNode)
 {
-    // 使用服务层生成游戏数据模型
-    _gameModel = GameModelGenerator::generateFromLevelConfig(levelConfig);
-    if (!_gameModel)
+    return startGame(_levelId + 1, parentNode);
+}
+
+bool GameController::restartGame(Node* parentNode)
+{
+    return startGame(_levelId, parentNode);
+}
+
+void GameController::releaseGameView()
+{
+    // 卡牌视图回收后在下一局复用
+    if (_gameView)
     {
-        CCLOG("Failed to generate game model");
-        return false;
+        _gameView->recycleCardViews();
+        _gameView->removeFromParent();
+        _gameView = nullptr;
     }
+}
 
-    return true;
+void GameController::releaseGame()
+{
+    // 视图持有数据模型的指针，先移除视图
+    releaseGameView();
+
+    _startSnapshot = GameModelSnapshot();
+    if (_gameModel)
+    {
+        delete _gameModel;
+        _gameModel = nullptr;
+    }
 }
 
 void GameController::initGameView(Node* parentNode)
 {
+    GAME_TRACE_SCOPE("createGameView");
+
     // 创建游戏视图，传入回调函数
     auto playfieldCallback = [this](int cardId) {
         this->handlePlayfieldCardClick(cardId);
@@ -90,11 +159,17 @@ void GameController::initGameView(Node* parentNode)
         this->handleUndoClick();
     };
 
-    _gameView = GameView::create(_gameModel, playfieldCallback, stackCallback, undoCallback);
+    auto redoCallback = [this]() {
+        this->handleRedoClick();
+    };
+
+    _gameView = GameView::create(_gameModel, playfieldCallback, stackCallback, undoCallback, redoCallback);
     if (_gameView)
     {
         parentNode->addChild(_gameView);
     }
+    GAME_TRACE_COUNTER("cardViewPoolCreated", CardViewPool::getInstance()->getStats().createdCount);
+    GAME_TRACE_COUNTER("cardViewPoolFree", CardViewPool::getInstance()->getStats().freeCount);
 }
 
 void GameController::handlePlayfieldCardClick(int cardId)
@@ -111,6 +186,13 @@ void GameController::handlePlayfieldCardClick(int cardId)
         return;
     }
 
+    // 被其他牌压住的卡牌不能点击
+    if (_gameModel->isCardBlocked(cardId))
+    {
+        CCLOG("Card %d is blocked", cardId);
+        return;
+    }
+
     // 检查是否可以匹配
     if (!CardMatchUtils::canMatchWithTray(clickedCard, trayCard))
     {
@@ -145,29 +227,57 @@ void GameController::handleUndoClick()
     }
 
     // 执行撤销
-    bool isFromStack = (undoModel.getActionType() == UAT_STACK_TO_TRAY);
-    executeUndo(undoModel.getCardId(),
-               undoModel.getPreviousTrayCardId(),
-               undoModel.getOriginalPosition(),
-               isFromStack);
+    executeUndo(undoModel);
 }
 
-void GameController::movePlayfieldCardToTray(int cardId)
+void GameController::handleRedoClick()
 {
+    if (!_gameModel || !_gameView || !_undoManager || !_undoManager->canRedo())
+    {
+        CCLOG("No redo available");
+        return;
+    }
+
+    UndoModel undoModel;
+    if (!_undoManager->popRedo(undoModel))
+    {
+        return;
+    }
+
+    GAME_TRACE_SCOPE("redo");
+
+    // 重做时记录已经重新成为撤销记录，不再重复添加
+    if (undoModel.getActionType() == UAT_STACK_TO_TRAY)
+    {
+        const auto& stackCards = _gameModel->getStackCards();
+        if (stackCards.empty()) return;
+        moveStackCardToTray(stackCards.back()->getId(), false);
+    }
+    else
+    {
+        const auto& playfieldSlots = _gameModel->getPlayfieldSlots();
+        const int slot = undoModel.getSourceIndex();
+        if (slot >= static_cast<int>(playfieldSlots.size())) return;
+        movePlayfieldCardToTray(playfieldSlots[slot]->getId(), false);
+    }
+}
+
+void GameController::movePlayfieldCardToTray(int cardId, bool recordUndo)
+{
+    GAME_TRACE_SCOPE_VALUE("movePlayfieldCard", cardId);
     CardModel* card = _gameModel->findCardById(cardId);
     CardModel* previousTrayCard = _gameModel->getTrayCard();
     if (!card || !previousTrayCard) return;
 
-    // 记录原始位置
-    Vec2 originalPos = card->getPosition();
-
-    // 记录撤销信息
-    UndoModel undoModel(UAT_PLAYFIELD_TO_TRAY, cardId,
-                       previousTrayCard->getId(), originalPos);
-    _undoManager->addUndo(undoModel);
+    // 记录撤销信息，卡牌的原始位置保存在卡牌数据中，不需要记录
+    if (recordUndo)
+    {
+        addUndoRecord(UndoModel(UAT_PLAYFIELD_TO_TRAY, _gameModel->getPlayfieldSlot(cardId), previousTrayCard->getId()));
+    }
 
-    // 从主牌区移除
-    _gameModel->removePlayfieldCard(card);
+    // 从主牌区移除，只有被它直接压住的牌可能因此露出
+    std::vector<int> exposedCardIds;
+    _gameModel->removePlayfieldCard(card, &exposedCardIds);
 
     // 设置为新的底牌
     _gameModel->setTrayCard(card);
@@ -181,26 +291,27 @@ void GameController::movePlayfieldCardToTray(int cardId)
 
         cardView->playMoveAnimation(localTrayPos, 0.3f, [this, cardView]() {
             // 动画完成后更新视图
+            GAME_TRACE_INSTANT_VALUE("moveAnimationDone", cardView->getCardId());
             _gameView->updateTrayCardView(cardView);
         });
     }
+    _gameView->updateBlockedCardViews(exposedCardIds);
 
     // 之前的底牌不需要移回主牌区，已被消除
 }
 
-void GameController::moveStackCardToTray(int cardId)
+void GameController::moveStackCardToTray(int cardId, bool recordUndo)
 {
+    GAME_TRACE_SCOPE_VALUE("moveStackCard", cardId);
     CardModel* card = _gameModel->findCardById(cardId);
     CardModel* previousTrayCard = _gameModel->getTrayCard();
     if (!card || !previousTrayCard) return;
 
-    // 记录原始位置
-    Vec2 originalPos = _gameView->getStackPosition();
-
-    // 记录撤销信息
-    UndoModel undoModel(UAT_STACK_TO_TRAY, cardId,
-                       previousTrayCard->getId(), originalPos);
-    _undoManager->addUndo(undoModel);
+    // 记录撤销信息，撤销时卡牌回到牌堆顶部，不需要记录下标
+    if (recordUndo)
+    {
+        addUndoRecord(UndoModel(UAT_STACK_TO_TRAY, 0, previousTrayCard->getId()));
+    }
 
     // 从备用牌堆移除
     _gameModel->removeStackCard(card);
@@ -216,6 +327,7 @@ void GameController::moveStackCardToTray(int cardId)
         Vec2 localTrayPos = cardView->getParent()->convertToNodeSpace(trayPos);
 
         cardView->playMoveAnimation(localTrayPos, 0.3f, [this, cardView]() {
+            GAME_TRACE_INSTANT_VALUE("moveAnimationDone", cardView->getCardId());
             _gameView->updateTrayCardView(cardView);
         });
     }
@@ -223,16 +335,33 @@ void GameController::moveStackCardToTray(int cardId)
     // 之前的底牌不需要移回备用牌堆，已被消除
 }
 
-void GameController::executeUndo(int cardId, int previousTrayCardId,
-                                const Vec2& originalPos, bool isFromStack)
+void GameController::addUndoRecord(const UndoModel& undoModel)
 {
-    CardModel* card = _gameModel->findCardById(cardId);
-    CardModel* previousTrayCard = _gameModel->findCardById(previousTrayCardId);
+    // 撤销按后进先出依次进行，跳过一条会让之前的记录全部错位，无效时清空整个历史
+    if (!undoModel.isValid())
+    {
+        CCLOG("Undo record out of range, undo history cleared");
+        _undoManager->clear();
+        return;
+    }
+    _undoManager->addUndo(undoModel);
+}
+
+void GameController::executeUndo(const UndoModel& undoModel)
+{
+    GAME_TRACE_SCOPE("undo");
+
+    // 撤销按后进先出的顺序进行，被移动的卡牌就是当前的底牌
+    CardModel* card = _gameModel->getTrayCard();
+    CardModel* previousTrayCard = _gameModel->findCardById(undoModel.getPreviousTrayCardId());
     if (!card || !previousTrayCard) return;
 
+    const int cardId = card->getId();
+    const bool isFromStack = (undoModel.getActionType() == UAT_STACK_TO_TRAY);
+
     // 更新视图
     CardView* cardView = _gameView->getCardView(cardId);
-    CardView* previousTrayView = _gameView->getCardView(previousTrayCardId);
+    CardView* previousTrayView = _gameView->getCardView(previousTrayCard->getId());
 
     if (!cardView || !previousTrayView) return;
 
@@ -248,6 +377,7 @@ void GameController::executeUndo(int cardId, int previousTrayCardId,
         // 目标位置：备用牌堆位置
         Vec2 targetPos = cardView->getParent()->convertToNodeSpace(_gameView->getStackPosition());
         cardView->playMoveAnimation(targetPos, 0.3f, [cardView]() {
+            GAME_TRACE_INSTANT_VALUE("undoAnimationDone", cardView->getCardId());
             cardView->setClickEnabled(true);
         });
     }
@@ -256,21 +386,24 @@ void GameController::executeUndo(int cardId, int previousTrayCardId,
         _gameView->addPlayfieldCardView(cardView);
         // 设置起始位置为底牌位置（在新父节点坐标系下）
         cardView->setPosition(cardView->getParent()->convertToNodeSpace(trayWorldPos));
-        // 目标位置：原始位置（已经是主牌区坐标系下的位置）
-        cardView->playMoveAnimation(originalPos, 0.3f, [cardView]() {
+        // 目标位置：卡牌数据中的原始位置（主牌区坐标系下）
+        cardView->playMoveAnimation(CocosVecAdapter::toCocos(card->getPosition()), 0.3f, [cardView]() {
+            GAME_TRACE_INSTANT_VALUE("undoAnimationDone", cardView->getCardId());
             cardView->setClickEnabled(true);
         });
     }
 
     // 2. 更新数据模型
-    card->setPosition(originalPos);
     if (isFromStack)
     {
         _gameModel->addStackCard(card);
     }
     else
     {
-        _gameModel->addPlayfieldCard(card);
+        // 重新压住移除时露出的那些牌
+        std::vector<int> blockedCardIds;
+        _gameModel->addPlayfieldCard(card, &blockedCardIds);
+        _gameView->updateBlockedCardViews(blockedCardIds);
     }
 
     // 3. 恢复之前的底牌
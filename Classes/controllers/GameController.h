@@ -2,11 +2,12 @@
 #define __GAME_CONTROLLER_H__
 
 #include "cocos2d.h"
+#include "../models/GameModel.h"
 
-class GameModel;
 class GameView;
-class LevelConfig;
+class LevelPrefetchManager;
 class UndoManager;
+class UndoModel;
 
 /**
  * @brief 游戏控制器
@@ -21,12 +22,31 @@ public:
 
     /**
      * @brief 开始游戏
+     * 已有进行中的关卡时先移除它；关卡已在后台预加载好时直接使用，否则同步加载
+     * 与当前关卡相同时恢复开局快照，不重新加载和生成数据模型
+     * 启动后在后台预加载下一关
      * @param levelId 关卡ID
      * @param parentNode 父节点，用于添加游戏视图
      * @return 启动成功返回true
      */
     bool startGame(int levelId, cocos2d::Node* parentNode);
 
+    /**
+     * @brief 进入下一关
+     * 下一关的数据已在后台准备好，这里只需要创建视图
+     * @param parentNode 父节点，用于添加游戏视图
+     * @return 启动成功返回true
+     */
+    bool startNextLevel(cocos2d::Node* parentNode);
+
+    /**
+     * @brief 重新开始当前关卡
+     * 恢复开局时的局面快照，只重建视图
+     * @param parentNode 父节点，用于添加游戏视图
+     * @return 启动成功返回true
+     */
+    bool restartGame(cocos2d::Node* parentNode);
+
     /**
      * @brief 处理主牌区卡牌点击
      * @param cardId 点击的卡牌ID
@@ -44,13 +64,21 @@ public:
      */
     void handleUndoClick();
 
+    /**
+     * @brief 处理重做按钮点击
+     */
+    void handleRedoClick();
+
 private:
     /**
-     * @brief 初始化游戏数据
-     * @param levelConfig 关卡配置
-     * @return 初始化成功返回true
+     * @brief 移除当前关卡的视图，回收卡牌视图
      */
-    bool initGameData(const LevelConfig* levelConfig);
+    void releaseGameView();
+
+    /**
+     * @brief 移除当前关卡的视图并释放数据模型
+     */
+    void releaseGame();
 
     /**
      * @brief 初始化游戏视图
@@ -61,29 +89,36 @@ private:
     /**
      * @brief 执行主牌区卡牌移动到底牌
      * @param cardId 卡牌ID
+     * @param recordUndo 是否添加撤销记录，重做时为false
      */
-    void movePlayfieldCardToTray(int cardId);
+    void movePlayfieldCardToTray(int cardId, bool recordUndo = true);
 
     /**
      * @brief 执行备用牌堆卡牌移动到底牌
      * @param cardId 卡牌ID
+     * @param recordUndo 是否添加撤销记录，重做时为false
+     */
+    void moveStackCardToTray(int cardId, bool recordUndo = true);
+
+    /**
+     * @brief 添加撤销记录，记录无效（下标或ID超出范围）时清空撤销历史
+     * @param undoModel 操作记录
      */
-    void moveStackCardToTray(int cardId);
+    void addUndoRecord(const UndoModel& undoModel);
 
     /**
      * @brief 执行撤销操作
-     * @param cardId 要撤销的卡牌ID
-     * @param previousTrayCardId 之前的底牌ID
-     * @param originalPos 原始位置
-     * @param isFromStack 是否来自备用牌堆
+     * @param undoModel 要撤销的操作记录
      */
-    void executeUndo(int cardId, int previousTrayCardId,
-                    const cocos2d::Vec2& originalPos, bool isFromStack);
+    void executeUndo(const UndoModel& undoModel);
 
 private:
     GameModel* _gameModel;          // 游戏数据模型
     GameView* _gameView;            // 游戏视图
     UndoManager* _undoManager;      // 撤销管理器
+    LevelPrefetchManager* _prefetchManager;     // 关卡预加载管理器
+    int _levelId;                   // 当前关卡ID
+    GameModelSnapshot _startSnapshot;   // 当前关卡开局时的局面，重新开始时恢复
 };
 
 #endif // __GAME_CONTROLLER_H__
@@ -0,0 +1,224 @@
+#include "LevelPrefetchManager.h"
+#include "../models/GameModel.h"
+#include "../configs/models/CompiledLevel.h"
+#include "../configs/models/LevelConfig.h"
+#include "../configs/loaders/CompiledLevelLoader.h"
+#include "../configs/loaders/LevelConfigCache.h"
+#include "../configs/loaders/LevelPackLoader.h"
+#include "../services/GameModelGenerator.h"
+#include "../utils/TraceUtils.h"
+#include <algorithm>
+
+LevelPrefetchManager::LevelPrefetchManager()
+    : _loadingLevelId(0)
+    , _isLoading(false)
+    , _stopping(false)
+{
+}
+
+LevelPrefetchManager::~LevelPrefetchManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _requests.clear();
+    }
+    _requestAvailable.notify_all();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+    releaseResults(_completed);
+    releaseResults(_ready);
+}
+
+void LevelPrefetchManager::prefetch(int levelId)
+{
+    if (isReady(levelId)) return;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (isPending(levelId)) return;
+        for (const auto& result : _completed)
+        {
+            if (result.levelId == levelId) return;
+        }
+
+        _requests.push_back(levelId);
+        if (!_thread.joinable())
+        {
+            _thread = std::thread(&LevelPrefetchManager::workerLoop, this);
+        }
+    }
+    _requestAvailable.notify_one();
+}
+
+int LevelPrefetchManager::pollCompleted()
+{
+    // 后台线程只在存取队列时短暂持有锁，取不到锁就等下一次
+    std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return 0;
+
+    const int count = static_cast<int>(_completed.size());
+    moveCompletedToReady();
+    return count;
+}
+
+bool LevelPrefetchManager::isReady(int levelId) const
+{
+    for (const auto& result : _ready)
+    {
+        if (result.levelId == levelId) return true;
+    }
+    return false;
+}
+
+GameModel* LevelPrefetchManager::tryTakeGameModel(int levelId)
+{
+    pollCompleted();
+
+    GameModel* gameModel = nullptr;
+    takeReady(levelId, gameModel);
+    return gameModel;
+}
+
+GameModel* LevelPrefetchManager::takeGameModel(int levelId)
+{
+    GameModel* gameModel = nullptr;
+    if (takeReady(levelId, gameModel)) return gameModel;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // 要用的关卡排在其他请求后面时先加载它
+        auto it = std::find(_requests.begin(), _requests.end(), levelId);
+        if (it != _requests.end() && it != _requests.begin())
+        {
+            _requests.erase(it);
+            _requests.push_front(levelId);
+        }
+
+        _resultAvailable.wait(lock, [this, levelId]() { return !isPending(levelId); });
+        moveCompletedToReady();
+    }
+
+    takeReady(levelId, gameModel);
+    return gameModel;
+}
+
+void LevelPrefetchManager::retainLevels(int firstLevelId, int lastLevelId)
+{
+    auto isStale = [firstLevelId, lastLevelId](int levelId) {
+        return levelId < firstLevelId || levelId > lastLevelId;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _requests.erase(std::remove_if(_requests.begin(), _requests.end(), isStale), _requests.end());
+        moveCompletedToReady();
+    }
+
+    // 正在加载的过期关卡完成后留在完成队列，下次窗口移动时释放
+    std::deque<PrefetchResult> staleResults;
+    std::deque<PrefetchResult> keptResults;
+    for (auto& result : _ready)
+    {
+        (isStale(result.levelId) ? staleResults : keptResults).push_back(result);
+    }
+    _ready.swap(keptResults);
+    releaseResults(staleResults);
+}
+
+void LevelPrefetchManager::clear()
+{
+    std::deque<PrefetchResult> results;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _requests.clear();
+        results.swap(_completed);
+    }
+    releaseResults(results);
+    releaseResults(_ready);
+}
+
+GameModel* LevelPrefetchManager::loadGameModel(int levelId)
+{
+    GAME_TRACE_SCOPE_VALUE("loadGameModel", levelId);
+
+    // 优先使用编译好的关卡（关卡包中的或单独的.bin文件），直接生成数据模型，不需要解析JSON；
+    // 开发构建中关卡JSON在编译后改过时改用JSON
+    CompiledLevel compiledLevel;
+    if ((LevelPackLoader::loadLevel(levelId, compiledLevel)
+         || CompiledLevelLoader::loadCompiledLevel(levelId, compiledLevel))
+        && CompiledLevelLoader::isSourceUpToDate(levelId, compiledLevel))
+    {
+        return GameModelGenerator::generateFromCompiledLevel(&compiledLevel);
+    }
+
+    // 解析好的配置由缓存持有，重玩或返回已玩过的关卡时不再读取和解析
+    std::shared_ptr<const LevelConfig> levelConfig = LevelConfigCache::getInstance()->getLevelConfig(levelId);
+    if (!levelConfig) return nullptr;
+
+    return GameModelGenerator::generateFromLevelConfig(levelConfig.get());
+}
+
+void LevelPrefetchManager::workerLoop()
+{
+    GAME_TRACE_THREAD_NAME("LevelPrefetch");
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _requestAvailable.wait(lock, [this]() { return _stopping || !_requests.empty(); });
+        if (_stopping) return;
+
+        PrefetchResult result;
+        result.levelId = _requests.front();
+        _requests.pop_front();
+        _loadingLevelId = result.levelId;
+        _isLoading = true;
+
+        // 加载期间不持有锁，主线程可以继续提交请求
+        lock.unlock();
+        result.gameModel = loadGameModel(result.levelId);
+        lock.lock();
+
+        _completed.push_back(result);
+        _isLoading = false;
+        _resultAvailable.notify_all();
+    }
+}
+
+bool LevelPrefetchManager::isPending(int levelId) const
+{
+    if (_isLoading && _loadingLevelId == levelId) return true;
+    return std::find(_requests.begin(), _requests.end(), levelId) != _requests.end();
+}
+
+bool LevelPrefetchManager::takeReady(int levelId, GameModel*& outGameModel)
+{
+    for (auto it = _ready.begin(); it != _ready.end(); ++it)
+    {
+        if (it->levelId != levelId) continue;
+
+        outGameModel = it->gameModel;
+        _ready.erase(it);
+        return true;
+    }
+    return false;
+}
+
+void LevelPrefetchManager::moveCompletedToReady()
+{
+    _ready.insert(_ready.end(), _completed.begin(), _completed.end());
+    _completed.clear();
+}
+
+void LevelPrefetchManager::releaseResults(std::deque<PrefetchResult>& results)
+{
+    for (auto& result : results)
+    {
+        delete result.gameModel;
+    }
+    results.clear();
+}
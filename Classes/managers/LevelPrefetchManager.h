@@ -0,0 +1,141 @@
+#ifndef __LEVEL_PREFETCH_MANAGER_H__
+#define __LEVEL_PREFETCH_MANAGER_H__
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class GameModel;
+
+/**
+ * @brief 关卡预加载管理器
+ * 作为Controller的成员变量，在后台线程中加载关卡文件并生成GameModel，
+ * 玩当前关卡时提前准备下一关，切换关卡时主线程只需要创建视图
+ * 加载结果通过完成队列交给主线程：主线程每帧用pollCompleted不等待地取回已完成的结果，
+ * 切换关卡时从取回的结果中拿走需要的关卡；除loadGameModel外的接口都只能在主线程调用
+ */
+class LevelPrefetchManager
+{
+public:
+    LevelPrefetchManager();
+
+    /**
+     * @brief 停止后台线程，释放未被取走的结果
+     * 正在加载的关卡会等它加载完
+     */
+    ~LevelPrefetchManager();
+
+    /**
+     * @brief 请求在后台加载关卡
+     * 第一次调用时启动后台线程；该关卡已在排队、正在加载或已加载完成时忽略
+     * @param levelId 关卡ID
+     */
+    void prefetch(int levelId);
+
+    /**
+     * @brief 把完成队列中的结果取回主线程，不等待后台线程
+     * 后台线程正好持有锁时本次不取，下次再取
+     * @return 本次取回的结果数量
+     */
+    int pollCompleted();
+
+    /**
+     * @brief 关卡是否已加载完成并取回主线程（见pollCompleted）
+     * @param levelId 关卡ID
+     * @return 可以立即取走时返回true
+     */
+    bool isReady(int levelId) const;
+
+    /**
+     * @brief 取走已加载完成的关卡数据，不等待
+     * @param levelId 关卡ID
+     * @return 游戏数据模型，调用方负责释放；还没加载完、未请求过或加载失败时返回nullptr
+     */
+    GameModel* tryTakeGameModel(int levelId);
+
+    /**
+     * @brief 取走预加载的关卡数据
+     * 关卡已请求但还没加载完时把它提到队首并等待它完成，不会重复加载；其他关卡的请求和结果保留
+     * @param levelId 关卡ID
+     * @return 游戏数据模型，调用方负责释放；未请求过该关卡或加载失败时返回nullptr
+     */
+    GameModel* takeGameModel(int levelId);
+
+    /**
+     * @brief 关卡窗口移动时丢弃窗口之外的排队请求和加载结果
+     * 窗口内的结果保留，例如重新开始第N关时不丢弃已加载好的第N+1关
+     * @param firstLevelId 窗口内的第一个关卡ID
+     * @param lastLevelId 窗口内的最后一个关卡ID
+     */
+    void retainLevels(int firstLevelId, int lastLevelId);
+
+    /**
+     * @brief 丢弃所有排队的请求和未取走的结果
+     */
+    void clear();
+
+    /**
+     * @brief 同步加载关卡并生成游戏数据模型
+     * 依次尝试关卡包、单独的编译关卡文件和关卡JSON（经过LevelConfigCache），可在任意线程调用
+     * 开发构建中关卡JSON在编译后改过时跳过过期的编译结果（见CompiledLevelLoader::isSourceUpToDate）
+     * @param levelId 关卡ID
+     * @return 游戏数据模型，调用方负责释放；加载失败时返回nullptr
+     */
+    static GameModel* loadGameModel(int levelId);
+
+private:
+    LevelPrefetchManager(const LevelPrefetchManager&) = delete;
+    LevelPrefetchManager& operator=(const LevelPrefetchManager&) = delete;
+
+    /**
+     * @brief 完成队列中的一项
+     */
+    struct PrefetchResult
+    {
+        int levelId;
+        GameModel* gameModel;   // 加载失败时为nullptr
+    };
+
+    /**
+     * @brief 后台线程主循环：取出请求，加载后放入完成队列
+     */
+    void workerLoop();
+
+    /**
+     * @brief 关卡是否在排队或正在加载（调用时需持有_mutex）
+     */
+    bool isPending(int levelId) const;
+
+    /**
+     * @brief 从已取回的结果中取走关卡数据
+     * @param levelId 关卡ID
+     * @param outGameModel 游戏数据模型，加载失败时为nullptr
+     * @return 已取回的结果中有该关卡时返回true
+     */
+    bool takeReady(int levelId, GameModel*& outGameModel);
+
+    /**
+     * @brief 把完成队列中的结果移到已取回的结果中（调用时需持有_mutex）
+     */
+    void moveCompletedToReady();
+
+    /**
+     * @brief 释放结果中的游戏数据模型
+     */
+    static void releaseResults(std::deque<PrefetchResult>& results);
+
+private:
+    std::thread _thread;                        // 后台加载线程，第一次请求时启动
+    std::deque<PrefetchResult> _ready;          // 已取回主线程的结果，只在主线程访问
+    std::mutex _mutex;                          // 保护以下所有成员
+    std::condition_variable _requestAvailable;  // 有新请求或正在停止
+    std::condition_variable _resultAvailable;   // 有关卡加载完成
+    std::deque<int> _requests;                  // 排队的关卡ID
+    std::deque<PrefetchResult> _completed;      // 完成队列
+    int _loadingLevelId;                        // 正在加载的关卡ID，_isLoading为true时有效
+    bool _isLoading;                            // 后台线程是否正在加载
+    bool _stopping;                             // 是否正在停止
+};
+
+#endif // __LEVEL_PREFETCH_MANAGER_H__
@@ -1,6 +1,12 @@
 #include "UndoManager.h"
 
-UndoManager::UndoManager()
+const int UndoManager::kDefaultCapacity;
+
+UndoManager::UndoManager(int capacity)
+    : _records(capacity > 0 ? capacity : 1)
+    , _head(0)
+    , _undoCount(0)
+    , _redoCount(0)
 {
 }
 
@@ -10,33 +16,51 @@ UndoManager::~UndoManager()
 
 void UndoManager::addUndo(const UndoModel& undoModel)
 {
-    _undoStack.push_back(undoModel);
+    // 新操作使之前撤销的记录失效
+    _redoCount = 0;
+
+    if (_undoCount == getCapacity())
+    {
+        // 缓冲已满，覆盖最早的一条
+        _records[_head] = undoModel;
+        _head = getRecordIndex(1);
+        return;
+    }
+
+    _records[getRecordIndex(_undoCount)] = undoModel;
+    _undoCount++;
 }
 
 bool UndoManager::popUndo(UndoModel& outModel)
 {
-    if (_undoStack.empty())
+    if (_undoCount == 0)
     {
         return false;
     }
 
-    // 拷贝栈顶元素并弹出
-    outModel = _undoStack.back();
-    _undoStack.pop_back();
+    // 记录仍留在缓冲中，作为第一条重做记录
+    _undoCount--;
+    _redoCount++;
+    outModel = _records[getRecordIndex(_undoCount)];
     return true;
 }
 
-bool UndoManager::canUndo() const
+bool UndoManager::popRedo(UndoModel& outModel)
 {
-    return !_undoStack.empty();
-}
+    if (_redoCount == 0)
+    {
+        return false;
+    }
 
-int UndoManager::getUndoCount() const
-{
-    return static_cast<int>(_undoStack.size());
+    outModel = _records[getRecordIndex(_undoCount)];
+    _undoCount++;
+    _redoCount--;
+    return true;
 }
 
 void UndoManager::clear()
 {
-    _undoStack.clear();
+    _head = 0;
+    _undoCount = 0;
+    _redoCount = 0;
 }
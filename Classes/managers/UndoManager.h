@@ -3,51 +3,93 @@
 
 #include "../models/UndoModel.h"
 #include <vector>
-#include <functional>
 
 /**
  * @brief 撤销管理器
  * 作为Controller的成员变量，负责管理撤销操作的历史记录
  * 持有UndoModel数据并提供撤销/重做功能
+ * 记录保存在固定容量的环形缓冲中，超出容量时丢弃最早的记录；
+ * 撤销的记录留在缓冲中作为重做记录，添加新记录时清空重做记录
  */
 class UndoManager
 {
 public:
-    UndoManager();
+    static const int kDefaultCapacity = 1024;   // 默认最多保存的撤销步数
+
+    /**
+     * @param capacity 最多保存的撤销步数，小于1时按1处理
+     */
+    explicit UndoManager(int capacity = kDefaultCapacity);
     ~UndoManager();
 
     /**
      * @brief 添加一条撤销记录
+     * 清空所有重做记录，缓冲已满时丢弃最早的一条
      * @param undoModel 撤销数据模型
      */
     void addUndo(const UndoModel& undoModel);
 
     /**
      * @brief 执行撤销操作
+     * 弹出的记录转为重做记录
      * @param outModel 输出参数，保存撤销的操作数据
      * @return 有可撤销操作返回true，否则返回false
      */
     bool popUndo(UndoModel& outModel);
 
+    /**
+     * @brief 执行重做操作
+     * 弹出的记录重新成为最新的撤销记录
+     * @param outModel 输出参数，保存重做的操作数据
+     * @return 有可重做操作返回true，否则返回false
+     */
+    bool popRedo(UndoModel& outModel);
+
     /**
      * @brief 判断是否有可撤销的操作
      * @return 有可撤销操作返回true
      */
-    bool canUndo() const;
+    bool canUndo() const { return _undoCount > 0; }
+
+    /**
+     * @brief 判断是否有可重做的操作
+     * @return 有可重做操作返回true
+     */
+    bool canRedo() const { return _redoCount > 0; }
 
     /**
      * @brief 获取撤销历史记录数量
      * @return 撤销历史记录的数量
      */
-    int getUndoCount() const;
+    int getUndoCount() const { return _undoCount; }
 
     /**
-     * @brief 清空所有撤销记录
+     * @brief 获取重做记录数量
+     * @return 重做记录的数量
+     */
+    int getRedoCount() const { return _redoCount; }
+
+    /**
+     * @brief 获取最多保存的撤销步数
+     */
+    int getCapacity() const { return static_cast<int>(_records.size()); }
+
+    /**
+     * @brief 清空所有撤销和重做记录
      */
     void clear();
 
 private:
-    std::vector<UndoModel> _undoStack;  // 撤销操作栈
+    /**
+     * @brief 获取从最早记录开始第offset条记录在缓冲中的下标
+     */
+    int getRecordIndex(int offset) const { return (_head + offset) % static_cast<int>(_records.size()); }
+
+private:
+    std::vector<UndoModel> _records;    // 环形缓冲，创建时分配，之后不再扩容
+    int _head;                          // 最早一条记录的下标
+    int _undoCount;                     // 撤销记录数量，紧接其后的是重做记录
+    int _redoCount;                     // 重做记录数量
 };
 
 #endif // __UNDO_MANAGER_H__
@@ -4,9 +4,8 @@ CardModel::CardModel()
     : _id(0)
     , _face(CFT_NONE)
     , _suit(CST_NONE)
-    , _position(cocos2d::Vec2::ZERO)
+    , _position(Vec2f())
     , _isFaceUp(true)
-    , _isBlocked(false)
     , _zOrder(0)
 {
 }
@@ -15,17 +14,12 @@ CardModel::CardModel(int id, CardFaceType face, CardSuitType suit)
     : _id(id)
     , _face(face)
     , _suit(suit)
-    , _position(cocos2d::Vec2::ZERO)
+    , _position(Vec2f())
     , _isFaceUp(true)
-    , _isBlocked(false)
     , _zOrder(0)
 {
 }
 
-CardModel::~CardModel()
-{
-}
-
 bool CardModel::isRed() const
 {
     return _suit == CST_HEARTS || _suit == CST_DIAMONDS;
@@ -1,7 +1,7 @@
 #ifndef __CARD_MODEL_H__
 #define __CARD_MODEL_H__
 
-#include "cocos2d.h"
+#include "../utils/Vec2f.h"
 
 // 花色类型
 enum CardSuitType
@@ -43,7 +43,6 @@ class CardModel
 public:
     CardModel();
     CardModel(int id, CardFaceType face, CardSuitType suit);
-    ~CardModel();
 
     /**
      * @brief 获取卡牌ID
@@ -67,7 +66,7 @@ public:
      * @brief 获取卡牌位置
      * @return 卡牌当前位置
      */
-    const cocos2d::Vec2& getPosition() const { return _position; }
+    const Vec2f& getPosition() const { return _position; }
 
     /**
      * @brief 设置卡牌ID
@@ -91,7 +90,7 @@ public:
      * @brief 设置卡牌位置
      * @param position 卡牌位置
      */
-    void setPosition(const cocos2d::Vec2& position) { _position = position; }
+    void setPosition(const Vec2f& position) { _position = position; }
 
     /**
      * @brief 判断花色是否为红色
@@ -111,13 +110,6 @@ public:
     bool isFaceUp() const { return _isFaceUp; }
     void setFaceUp(bool faceUp) { _isFaceUp = faceUp; }
 
-    /**
-     * @brief 设置/获取卡牌是否被遮挡
-     * 被遮挡的卡牌不能点击
-     */
-    bool isBlocked() const { return _isBlocked; }
-    void setBlocked(bool blocked) { _isBlocked = blocked; }
-
     /**
      * @brief 设置/获取Z轴层级
      */
@@ -128,9 +120,8 @@ private:
     int _id;                    // 卡牌唯一ID
     CardFaceType _face;         // 卡牌点数
     CardSuitType _suit;         // 卡牌花色
-    cocos2d::Vec2 _position;    // 卡牌位置
+    Vec2f _position;            // 卡牌位置
     bool _isFaceUp;             // 是否翻开
-    bool _isBlocked;            // 是否被其他牌遮挡
     int _zOrder;                // Z轴层级
 };
 
@@ -1,92 +1,316 @@
 #include "GameModel.h"
+#include "../utils/CardMatchUtils.h"
+#include "../utils/ZobristHash.h"
 #include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+// 卡牌存储整体释放时不需要逐个析构
+static_assert(std::is_trivially_destructible<CardModel>::value, "CardModel must stay trivially destructible");
+
+const int GameModel::kMaxCardCount;
+
+namespace
+{
+    /**
+     * @brief 分配新的数据代数
+     * 所有GameModel共用一个计数，释放后在同一地址新建的GameModel也不会接受旧快照；
+     * 预加载线程也会创建GameModel，计数为原子变量
+     */
+    uint64_t allocateGeneration()
+    {
+        static std::atomic<uint64_t> s_nextGeneration(1);
+        return s_nextGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+}
 
 GameModel::GameModel()
-    : _trayCard(nullptr)
+    : _state(std::make_shared<GameRoundState>())
+    , _stateShared(false)
+    , _generation(allocateGeneration())
 {
 }
 
 GameModel::~GameModel()
 {
-    clear();
+    // 成员随对象一起释放；不调用clear，它会为之后继续使用分配新的局面数据
+}
+
+bool GameModel::reserveCards(int count)
+{
+    if (!_cardStorage.empty() || count > kMaxCardCount) return false;
+
+    const size_t capacity = count > 0 ? static_cast<size_t>(count) : 0;
+    _cardStorage.reserve(capacity);
+    _playfieldSlotById.assign(capacity, -1);
+
+    // 存活掩码按卡牌总数一次分配，开局加入主牌区时不再扩容
+    GameRoundState& state = getMutableState();
+    state.playfieldAliveMask.assign((capacity + 63) / 64, 0);
+    state.coveredCounts.assign(capacity, 0);
+    return true;
+}
+
+CardModel* GameModel::createCard(CardFaceType face, CardSuitType suit)
+{
+    // 不允许扩容，否则已发出的卡牌指针会失效
+    if (_cardStorage.size() >= _cardStorage.capacity()) return nullptr;
+
+    const int id = static_cast<int>(_cardStorage.size());
+    _cardStorage.push_back(CardModel(id, face, suit));
+    return &_cardStorage.back();
+}
+
+int GameModel::getPlayfieldCards(std::vector<CardModel*>& outCards) const
+{
+    outCards.clear();
+    for (size_t slot = 0; slot < _playfieldSlots.size(); slot++)
+    {
+        if (isPlayfieldSlotAlive(static_cast<int>(slot))) outCards.push_back(_playfieldSlots[slot]);
+    }
+    return static_cast<int>(outCards.size());
+}
+
+int GameModel::getLegalPlayfieldCards(std::vector<CardModel*>& outCards) const
+{
+    outCards.clear();
+    if (!_state->trayCard) return 0;
+
+    // 已移除的槽位和被遮挡的卡牌一样视为不可点击
+    const int count = static_cast<int>(_playfieldSlots.size());
+    std::vector<uint8_t> exposedFaces(count);
+    for (int slot = 0; slot < count; slot++)
+    {
+        const CardModel* card = _playfieldSlots[slot];
+        exposedFaces[slot] = !isPlayfieldSlotAlive(slot) || isCardBlocked(card->getId())
+                           ? CardMatchUtils::kNoFace : static_cast<uint8_t>(card->getFace());
+    }
+
+    std::vector<uint64_t> legalMask((count + 63) / 64);
+    CardMatchUtils::getLegalMoveMask(_state->trayCard->getFace(), exposedFaces.data(), count, legalMask.data());
+
+    for (int slot = 0; slot < count; slot++)
+    {
+        if ((legalMask[slot >> 6] >> (slot & 63)) & 1)
+        {
+            outCards.push_back(_playfieldSlots[slot]);
+        }
+    }
+    return static_cast<int>(outCards.size());
+}
+
+void GameModel::setCardBlockers(std::vector<int> blockerOffsets, std::vector<int> blockerIds)
+{
+    const int cardCount = getCardCount();
+    _blockerOffsets.clear();
+    _blockerIds.clear();
+    _coveredOffsets.clear();
+    _coveredIds.clear();
+    if (blockerOffsets.size() < 2) return;
+
+    // 偏移覆盖的卡牌不超过本局卡牌数量，之后的卡牌没有遮挡者
+    const int coveredCount = std::min(static_cast<int>(blockerOffsets.size()) - 1, cardCount);
+    blockerOffsets.resize(coveredCount + 1);
+
+    // 原地去掉超出范围的ID，同时统计每张卡牌压住的卡牌数量
+    std::vector<int> coveredOffsets(cardCount + 1, 0);
+    int write = 0;
+    for (int cardId = 0; cardId < coveredCount; cardId++)
+    {
+        const int begin = std::max(blockerOffsets[cardId], write);
+        const int end = std::min(std::max(blockerOffsets[cardId + 1], begin), static_cast<int>(blockerIds.size()));
+        blockerOffsets[cardId] = write;
+        for (int i = begin; i < end; i++)
+        {
+            const int blockerId = blockerIds[i];
+            if (blockerId < 0 || blockerId >= cardCount) continue;
+            blockerIds[write++] = blockerId;
+            coveredOffsets[blockerId + 1]++;
+        }
+    }
+    blockerOffsets[coveredCount] = write;
+    blockerIds.resize(write);
+
+    // 按卡牌ID顺序填入反向列表，每张卡牌压住的卡牌按ID升序
+    for (int cardId = 0; cardId < cardCount; cardId++)
+    {
+        coveredOffsets[cardId + 1] += coveredOffsets[cardId];
+    }
+    std::vector<int> coveredIds(write);
+    std::vector<int> coveredFill(coveredOffsets.begin(), coveredOffsets.end() - 1);
+    for (int cardId = 0; cardId < coveredCount; cardId++)
+    {
+        for (int i = blockerOffsets[cardId]; i < blockerOffsets[cardId + 1]; i++)
+        {
+            coveredIds[coveredFill[blockerIds[i]]++] = cardId;
+        }
+    }
+
+    _blockerOffsets = std::move(blockerOffsets);
+    _blockerIds = std::move(blockerIds);
+    _coveredOffsets = std::move(coveredOffsets);
+    _coveredIds = std::move(coveredIds);
 }
 
-CardModel* GameModel::findCardById(int cardId) const
+void GameModel::updateBlockedCards()
 {
-    auto it = _cardMap.find(cardId);
-    if (it != _cardMap.end())
+    const int cardCount = getCardCount();
+    std::vector<char> inPlayfield(cardCount, 0);
+    for (size_t slot = 0; slot < _playfieldSlots.size(); slot++)
+    {
+        if (isPlayfieldSlotAlive(static_cast<int>(slot))) inPlayfield[_playfieldSlots[slot]->getId()] = 1;
+    }
+
+    GameRoundState& state = getMutableState();
+    for (int cardId = 0; cardId < cardCount; cardId++)
     {
-        return it->second;
+        int count = 0;
+        for (int blockerId : getCardBlockers(cardId))
+        {
+            count += inPlayfield[blockerId];
+        }
+        state.coveredCounts[cardId] = count;
     }
-    return nullptr;
 }
 
-bool GameModel::removePlayfieldCard(CardModel* card)
+bool GameModel::removePlayfieldCard(CardModel* card, std::vector<int>* outExposedCardIds)
 {
     if (!card) return false;
 
-    auto it = std::find(_playfieldCards.begin(), _playfieldCards.end(), card);
-    if (it != _playfieldCards.end())
+    const int slot = getPlayfieldSlot(card->getId());
+    if (slot < 0 || !isPlayfieldSlotAlive(slot)) return false;
+
+    GameRoundState& state = getMutableState();
+    state.playfieldAliveMask[slot >> 6] &= ~(1ULL << (slot & 63));
+    state.playfieldCardCount--;
+    state.hash ^= ZobristHash::playfieldKey(card->getId());
+
+    // 只更新被它直接压住的卡牌
+    for (int coveredId : getCoveredCards(card->getId()))
     {
-        _playfieldCards.erase(it);
-        // 注意：不从cardMap中删除，因为卡牌对象仍然存在（会移到底牌区）
-        return true;
+        if (state.coveredCounts[coveredId] <= 0 || --state.coveredCounts[coveredId] > 0) continue;
+
+        if (outExposedCardIds) outExposedCardIds->push_back(coveredId);
     }
-    return false;
+    return true;
 }
 
 bool GameModel::removeStackCard(CardModel* card)
 {
     if (!card) return false;
 
-    auto it = std::find(_stackCards.begin(), _stackCards.end(), card);
-    if (it != _stackCards.end())
+    // 先确认卡牌在牌堆中，避免不必要的写时复制
+    const std::vector<CardModel*>& stackCards = _state->stackCards;
+    auto it = !stackCards.empty() && stackCards.back() == card
+            ? stackCards.end() - 1 : std::find(stackCards.begin(), stackCards.end(), card);
+    if (it == stackCards.end()) return false;
+    const size_t index = static_cast<size_t>(it - stackCards.begin());
+
+    // 通常移除的是顶部的牌，直接弹出
+    GameRoundState& state = getMutableState();
+    if (index + 1 == state.stackCards.size())
     {
-        _stackCards.erase(it);
-        // 注意：不从cardMap中删除，因为卡牌对象仍然存在（会移到底牌区）
-        return true;
+        state.stackCards.pop_back();
     }
-    return false;
+    else
+    {
+        state.stackCards.erase(state.stackCards.begin() + index);
+    }
+    state.hash ^= ZobristHash::stackKey(card->getId());
+    return true;
 }
 
-void GameModel::addPlayfieldCard(CardModel* card)
+void GameModel::addPlayfieldCard(CardModel* card, std::vector<int>* outBlockedCardIds)
 {
-    if (!card) return;
+    if (!card || card->getId() < 0 || card->getId() >= getCardCount()) return;
+
+    int slot = getPlayfieldSlot(card->getId());
+    if (slot < 0)
+    {
+        // 开局加入的卡牌按顺序分配新槽位
+        slot = static_cast<int>(_playfieldSlots.size());
+        _playfieldSlots.push_back(card);
+        _playfieldSlotById[card->getId()] = slot;
+    }
+    else if (isPlayfieldSlotAlive(slot))
+    {
+        return;
+    }
+
+    GameRoundState& state = getMutableState();
+    state.playfieldAliveMask[slot >> 6] |= 1ULL << (slot & 63);
+    state.playfieldCardCount++;
+    state.hash ^= ZobristHash::playfieldKey(card->getId());
+
+    for (int coveredId : getCoveredCards(card->getId()))
+    {
+        if (state.coveredCounts[coveredId]++ > 0) continue;
 
-    _playfieldCards.push_back(card);
-    // cardMap应该已经包含这张卡牌，但为了安全起见仍然设置
-    _cardMap[card->getId()] = card;
+        if (outBlockedCardIds) outBlockedCardIds->push_back(coveredId);
+    }
 }
 
 void GameModel::addStackCard(CardModel* card)
 {
     if (!card) return;
 
-    _stackCards.push_back(card);
-    // cardMap应该已经包含这张卡牌，但为了安全起见仍然设置
-    _cardMap[card->getId()] = card;
+    GameRoundState& state = getMutableState();
+    state.stackCards.push_back(card);
+    state.hash ^= ZobristHash::stackKey(card->getId());
 }
 
-void GameModel::clear()
+void GameModel::setTrayCard(CardModel* card)
 {
-    // 删除所有卡牌对象
-    for (auto card : _playfieldCards)
-    {
-        delete card;
-    }
-    _playfieldCards.clear();
+    GameRoundState& state = getMutableState();
+    state.hash ^= ZobristHash::trayKey(state.trayCard ? state.trayCard->getFace() : CFT_NONE);
+    state.trayCard = card;
+    state.hash ^= ZobristHash::trayKey(state.trayCard ? state.trayCard->getFace() : CFT_NONE);
+}
 
-    for (auto card : _stackCards)
-    {
-        delete card;
-    }
-    _stackCards.clear();
+GameModelSnapshot GameModel::createSnapshot() const
+{
+    GameModelSnapshot snapshot;
+    snapshot._generation = _generation;
+    snapshot._state = _state;
+    _stateShared = true;
+    return snapshot;
+}
+
+bool GameModel::restoreSnapshot(const GameModelSnapshot& snapshot)
+{
+    if (!snapshot.isValid() || snapshot._generation != _generation) return false;
+
+    // 与快照共享同一份数据，下次修改时再复制
+    _state = std::const_pointer_cast<GameRoundState>(snapshot._state);
+    _stateShared = true;
+    return true;
+}
 
-    if (_trayCard)
+GameRoundState& GameModel::getMutableState()
+{
+    if (_stateShared)
     {
-        delete _trayCard;
-        _trayCard = nullptr;
+        _state = std::make_shared<GameRoundState>(*_state);
+        _stateShared = false;
     }
+    return *_state;
+}
+
+void GameModel::clear()
+{
+    _playfieldSlots.clear();
+    _playfieldSlotById.clear();
+
+    // 快照可能仍持有旧的局面数据，换一份新的，不影响快照
+    _state = std::make_shared<GameRoundState>();
+    _stateShared = false;
+    _generation = allocateGeneration();
+
+    // 一次释放本局所有卡牌，包括已被压在底牌堆下面的卡牌
+    std::vector<CardModel>().swap(_cardStorage);
 
-    _cardMap.clear();
+    _blockerOffsets.clear();
+    _blockerIds.clear();
+    _coveredOffsets.clear();
+    _coveredIds.clear();
 }
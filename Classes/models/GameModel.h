@@ -2,61 +2,265 @@
 #define __GAME_MODEL_H__
 
 #include "CardModel.h"
+#include "UndoModel.h"
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <map>
+
+class GameModel;
+
+/**
+ * @brief 连续存放的卡牌ID的只读视图
+ * 指向GameModel中的遮挡关系数组，GameModel重新设置遮挡关系或clear后失效
+ */
+class CardIdRange
+{
+public:
+    CardIdRange(const int* begin, const int* end) : _begin(begin), _end(end) {}
+
+    const int* begin() const { return _begin; }
+    const int* end() const { return _end; }
+    int size() const { return static_cast<int>(_end - _begin); }
+    bool empty() const { return _begin == _end; }
+
+private:
+    const int* _begin;
+    const int* _end;
+};
+
+/**
+ * @brief 一局中随移动而变化的数据
+ * 卡牌本身、主牌区槽位和遮挡关系在开局后不再变化，留在GameModel中；
+ * 其余数据集中在这里，由GameModel和它的快照共享
+ */
+struct GameRoundState
+{
+    std::vector<uint64_t> playfieldAliveMask;   // 主牌区槽位存活掩码
+    int playfieldCardCount;                     // 仍在主牌区的卡牌数量
+    std::vector<CardModel*> stackCards;         // 备用牌堆卡牌列表
+    CardModel* trayCard;                        // 底牌
+    uint64_t hash;                              // 当前局面的Zobrist哈希
+    std::vector<int> coveredCounts;             // 按卡牌ID索引：仍在主牌区的遮挡者数量，大于0即被遮挡
+
+    GameRoundState()
+        : playfieldCardCount(0)
+        , trayCard(nullptr)
+        , hash(0)
+    {
+    }
+};
+
+/**
+ * @brief GameModel的局面快照
+ * 只持有共享的局面数据，创建和恢复都是O(1)；GameModel在快照之后第一次修改局面时才复制一份（写时复制）
+ * 只能恢复到创建它的GameModel，GameModel调用clear后之前的快照失效
+ * 快照持有的局面数据创建后不再被修改，可以交给其他线程（如提示搜索）只读访问；
+ * 创建和恢复快照须在使用该GameModel的线程上进行
+ */
+class GameModelSnapshot
+{
+public:
+    GameModelSnapshot()
+        : _generation(0)
+    {
+    }
+
+    /**
+     * @brief 判断快照是否有效（由GameModel::createSnapshot创建）
+     */
+    bool isValid() const { return _state != nullptr; }
+
+private:
+    friend class GameModel;
+
+    uint64_t _generation;                       // 创建时GameModel的数据代数，进程内唯一
+    std::shared_ptr<const GameRoundState> _state;   // 共享的局面数据
+};
 
 /**
  * @brief 游戏数据模型
  * 存储整个游戏的运行时数据，包括主牌区、底牌堆和备用牌堆的卡牌数据
+ * 本局所有卡牌都分配在GameModel持有的连续存储中，各区域列表只保存指针
+ * 卡牌ID为本局内从0开始的连续编号，即卡牌在存储中的下标，按ID查找均为数组访问
+ * 随移动变化的数据保存在共享的GameRoundState中，可以O(1)创建快照并恢复，用于提示搜索、教学回放和重新开始
  */
 class GameModel
 {
 public:
+    static const int kMaxCardCount = UndoModel::kMaxIndex + 1;     // 一局最多的卡牌数量，卡牌ID和槽位须能存入撤销记录
+
     GameModel();
     ~GameModel();
 
     /**
-     * @brief 获取主牌区的所有卡牌
-     * @return 主牌区卡牌列表的引用
+     * @brief 为本局的所有卡牌一次性分配存储
+     * 须在创建卡牌前调用，之后存储不再扩容，createCard返回的指针保持有效
+     * @param count 本局卡牌总数
+     * @return 分配成功返回true，已有卡牌或超过kMaxCardCount时返回false
+     */
+    bool reserveCards(int count);
+
+    /**
+     * @brief 在本局的卡牌存储中创建卡牌
+     * 卡牌由GameModel持有，在clear或GameModel销毁时统一释放，调用方不能delete
+     * 卡牌ID按创建顺序从0开始分配
+     * @param face 卡牌点数
+     * @param suit 卡牌花色
+     * @return 卡牌指针，超出reserveCards预留的数量时返回nullptr
+     */
+    CardModel* createCard(CardFaceType face, CardSuitType suit);
+
+    /**
+     * @brief 获取本局所有卡牌，按创建顺序（即卡牌ID）连续存放
+     * @return 卡牌存储的引用
+     */
+    const std::vector<CardModel>& getAllCards() const { return _cardStorage; }
+
+    /**
+     * @brief 获取仍在主牌区的卡牌
+     * @param outCards 输出参数，按槽位顺序保存仍在主牌区的卡牌
+     * @return 卡牌数量
+     */
+    int getPlayfieldCards(std::vector<CardModel*>& outCards) const;
+
+    /**
+     * @brief 获取主牌区的所有槽位
+     * 槽位在开局加入卡牌时按顺序分配，之后不再变化；已移除卡牌的槽位仍保留原卡牌指针
+     * @return 槽位列表的引用，需配合isPlayfieldSlotAlive判断卡牌是否还在
+     */
+    const std::vector<CardModel*>& getPlayfieldSlots() const { return _playfieldSlots; }
+
+    /**
+     * @brief 判断槽位上的卡牌是否还在主牌区
+     * @param slot 槽位下标
+     */
+    bool isPlayfieldSlotAlive(int slot) const { return (_state->playfieldAliveMask[slot >> 6] >> (slot & 63)) & 1; }
+
+    /**
+     * @brief 获取主牌区存活掩码，第slot位对应第slot个槽位
      */
-    std::vector<CardModel*>& getPlayfieldCards() { return _playfieldCards; }
-    const std::vector<CardModel*>& getPlayfieldCards() const { return _playfieldCards; }
+    const std::vector<uint64_t>& getPlayfieldAliveMask() const { return _state->playfieldAliveMask; }
+
+    /**
+     * @brief 根据卡牌ID获取主牌区槽位
+     * @param cardId 卡牌ID
+     * @return 槽位下标，不是主牌区卡牌返回-1（已移除的主牌区卡牌仍返回原槽位）
+     */
+    int getPlayfieldSlot(int cardId) const
+    {
+        if (cardId < 0 || cardId >= static_cast<int>(_playfieldSlotById.size())) return -1;
+        return _playfieldSlotById[cardId];
+    }
+
+    /**
+     * @brief 获取仍在主牌区的卡牌数量，为0时通关
+     */
+    int getPlayfieldCardCount() const { return _state->playfieldCardCount; }
 
     /**
      * @brief 获取备用牌堆的所有卡牌
-     * @return 备用牌堆卡牌列表的引用
+     * @return 备用牌堆卡牌列表的引用，顶部的牌在末尾
      */
-    std::vector<CardModel*>& getStackCards() { return _stackCards; }
-    const std::vector<CardModel*>& getStackCards() const { return _stackCards; }
+    const std::vector<CardModel*>& getStackCards() const { return _state->stackCards; }
 
     /**
      * @brief 获取底牌
      * @return 底牌指针，如果没有底牌返回nullptr
      */
-    CardModel* getTrayCard() const { return _trayCard; }
+    CardModel* getTrayCard() const { return _state->trayCard; }
 
     /**
      * @brief 设置底牌
      * @param card 底牌指针
      */
-    void setTrayCard(CardModel* card) { _trayCard = card; }
+    void setTrayCard(CardModel* card);
+
+    /**
+     * @brief 获取当前局面的Zobrist哈希
+     * 在每次增删卡牌和设置底牌时增量更新，相同局面（底牌只看点数）哈希相同
+     * @return 局面哈希
+     */
+    uint64_t getHash() const { return _state->hash; }
+
+    /**
+     * @brief 获取本局卡牌数量，卡牌ID的范围为[0, getCardCount())
+     */
+    int getCardCount() const { return static_cast<int>(_cardStorage.size()); }
 
     /**
      * @brief 根据ID查找卡牌
      * @param cardId 卡牌ID
      * @return 卡牌指针，找不到返回nullptr
      */
-    CardModel* findCardById(int cardId) const;
+    CardModel* findCardById(int cardId) const
+    {
+        if (cardId < 0 || cardId >= static_cast<int>(_cardStorage.size())) return nullptr;
+        return const_cast<CardModel*>(&_cardStorage[cardId]);
+    }
+
+    /**
+     * @brief 获取所有可以移动到底牌的主牌区卡牌
+     * 供提示、自动出牌等功能使用，内部通过CardMatchUtils::getLegalMoveMask一次生成，被遮挡的卡牌不计入
+     * @param outCards 输出参数，按主牌区列表顺序保存可移动的卡牌
+     * @return 可移动卡牌的数量
+     */
+    int getLegalPlayfieldCards(std::vector<CardModel*>& outCards) const;
+
+    /**
+     * @brief 一次设置所有卡牌的遮挡者（CSR格式）
+     * 卡牌cardId的遮挡者为blockerIds[blockerOffsets[cardId], blockerOffsets[cardId + 1])，
+     * blockerOffsets可以只覆盖前面的卡牌（如主牌区），之后的卡牌没有遮挡者；超出范围的ID被忽略
+     * 同时按相同格式生成反向的“压住”列表，所有遮挡关系只占四个数组，不按卡牌分配
+     * 设置后调用一次updateBlockedCards
+     * @param blockerOffsets 按卡牌ID的起始位置，末尾多一个结束位置
+     * @param blockerIds 所有卡牌的遮挡者ID，按卡牌ID顺序连续存放
+     */
+    void setCardBlockers(std::vector<int> blockerOffsets, std::vector<int> blockerIds);
+
+    /**
+     * @brief 获取主牌区卡牌的遮挡者
+     * @param cardId 卡牌ID
+     * @return 遮挡该卡牌的卡牌ID，没有遮挡时为空
+     */
+    CardIdRange getCardBlockers(int cardId) const { return getCardIds(_blockerOffsets, _blockerIds, cardId); }
+
+    /**
+     * @brief 获取被该卡牌直接压住的卡牌
+     * @param cardId 卡牌ID
+     * @return 被压住的卡牌ID，按卡牌ID升序，没有时为空
+     */
+    CardIdRange getCoveredCards(int cardId) const { return getCardIds(_coveredOffsets, _coveredIds, cardId); }
+
+    /**
+     * @brief 判断卡牌是否被仍在主牌区的其他卡牌遮挡
+     * 被遮挡的卡牌不能点击
+     * @param cardId 卡牌ID
+     */
+    bool isCardBlocked(int cardId) const
+    {
+        if (cardId < 0 || cardId >= static_cast<int>(_state->coveredCounts.size())) return false;
+        return _state->coveredCounts[cardId] > 0;
+    }
+
+    /**
+     * @brief 根据遮挡者是否还在主牌区，重新计算所有卡牌的被遮挡计数
+     * 开局或整体重建局面后调用一次，单步移动和撤销由removePlayfieldCard/addPlayfieldCard增量维护
+     */
+    void updateBlockedCards();
 
     /**
      * @brief 从主牌区移除卡牌
+     * 只清除卡牌槽位的存活位，O(1)且不改变其他卡牌的顺序
+     * 被它直接压住的卡牌遮挡计数减一，计数归零的卡牌解除遮挡
      * @param card 要移除的卡牌指针
-     * @return 移除成功返回true
+     * @param outExposedCardIds 可选输出参数，追加因此解除遮挡的卡牌ID
+     * @return 移除成功返回true，卡牌不在主牌区时返回false
      */
-    bool removePlayfieldCard(CardModel* card);
+    bool removePlayfieldCard(CardModel* card, std::vector<int>* outExposedCardIds = nullptr);
 
     /**
      * @brief 从备用牌堆移除卡牌
+     * 正常游戏只会移除顶部（列表末尾）的牌，为O(1)
      * @param card 要移除的卡牌指针
      * @return 移除成功返回true
      */
@@ -64,9 +268,12 @@ public:
 
     /**
      * @brief 添加卡牌到主牌区
+     * 已有槽位的卡牌（撤销时）重新设置存活位，回到原来的位置；没有槽位的卡牌（开局时）分配新槽位
+     * 被它直接压住的卡牌遮挡计数加一，撤销时恰好还原removePlayfieldCard的改动
      * @param card 要添加的卡牌指针
+     * @param outBlockedCardIds 可选输出参数，追加因此重新被遮挡的卡牌ID
      */
-    void addPlayfieldCard(CardModel* card);
+    void addPlayfieldCard(CardModel* card, std::vector<int>* outBlockedCardIds = nullptr);
 
     /**
      * @brief 添加卡牌到备用牌堆
@@ -74,16 +281,55 @@ public:
      */
     void addStackCard(CardModel* card);
 
+    /**
+     * @brief 创建当前局面的快照，O(1)
+     * @return 快照对象
+     */
+    GameModelSnapshot createSnapshot() const;
+
+    /**
+     * @brief 恢复到快照时的局面，O(1)
+     * 恢复后卡牌视图需要由调用方按新局面刷新
+     * @param snapshot 由本对象创建的快照
+     * @return 恢复成功返回true，快照无效或不属于本局时返回false
+     */
+    bool restoreSnapshot(const GameModelSnapshot& snapshot);
+
     /**
      * @brief 清空所有数据
+     * 卡牌存储整体释放，包括已经消除到底牌堆下面的卡牌；之前创建的快照全部失效
      */
     void clear();
 
 private:
-    std::vector<CardModel*> _playfieldCards;  // 主牌区卡牌列表
-    std::vector<CardModel*> _stackCards;      // 备用牌堆卡牌列表
-    CardModel* _trayCard;                     // 底牌
-    std::map<int, CardModel*> _cardMap;       // 卡牌ID到卡牌的映射表，用于快速查找
+    GameModel(const GameModel&) = delete;
+    GameModel& operator=(const GameModel&) = delete;
+
+    /**
+     * @brief 从CSR数组中取出一张卡牌的ID列表，超出范围时为空
+     */
+    static CardIdRange getCardIds(const std::vector<int>& offsets, const std::vector<int>& ids, int cardId)
+    {
+        if (cardId < 0 || cardId + 1 >= static_cast<int>(offsets.size())) return CardIdRange(nullptr, nullptr);
+        return CardIdRange(ids.data() + offsets[cardId], ids.data() + offsets[cardId + 1]);
+    }
+
+    /**
+     * @brief 获取可写的局面数据，与快照共享时先复制一份
+     * 按_stateShared判断而不是shared_ptr::use_count，其他线程释放快照时结果也是确定的
+     */
+    GameRoundState& getMutableState();
+
+    std::vector<CardModel> _cardStorage;      // 本局所有卡牌的连续存储，下标即卡牌ID，容量在reserveCards时固定
+    std::vector<CardModel*> _playfieldSlots;  // 主牌区槽位，顺序固定，移除卡牌只清除存活位
+    std::vector<int> _playfieldSlotById;      // 按卡牌ID索引：主牌区槽位，不是主牌区卡牌为-1
+    std::vector<int> _blockerOffsets;         // 按卡牌ID索引：遮挡者在_blockerIds中的起始位置，末尾多一个结束位置
+    std::vector<int> _blockerIds;             // 所有卡牌的遮挡者ID，按卡牌ID顺序连续存放
+    std::vector<int> _coveredOffsets;         // 按卡牌ID索引：被压住的卡牌在_coveredIds中的起始位置，末尾多一个结束位置
+    std::vector<int> _coveredIds;             // 所有卡牌直接压住的卡牌ID，按卡牌ID顺序连续存放
+    std::shared_ptr<GameRoundState> _state;   // 随移动变化的局面数据，可能与快照共享
+    mutable bool _stateShared;                // _state是否可能被快照持有，为true时修改前先复制
+    uint64_t _generation;                     // 数据代数，构造和clear时从全局计数分配，用于识别失效或不属于本对象的快照
 };
 
 #endif // __GAME_MODEL_H__
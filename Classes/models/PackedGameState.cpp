@@ -0,0 +1,245 @@
+#include "PackedGameState.h"
+#include "GameModel.h"
+#include "CardModel.h"
+#include "../utils/CardMatchUtils.h"
+#include "../utils/ZobristHash.h"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<PackedGameState>::value,
+              "PackedGameState must stay trivially copyable");
+
+PackedGameLayout::PackedGameLayout()
+    : _initialTrayCardId(0)
+    , _initialTrayFace(0)
+{
+}
+
+bool PackedGameLayout::buildFromGameModel(const GameModel* gameModel)
+{
+    _playfieldCardIds.clear();
+    _playfieldFaces.clear();
+    _stackCardIds.clear();
+    _stackFaces.clear();
+    _playfieldKeys.clear();
+    _stackKeys.clear();
+    _playfieldBlockerMasks.clear();
+    _playfieldCoverMasks.clear();
+    _cardIndexById.clear();
+
+    if (!gameModel || !gameModel->getTrayCard()) return false;
+
+    std::vector<CardModel*> playfieldCards;
+    gameModel->getPlayfieldCards(playfieldCards);
+    const auto& stackCards = gameModel->getStackCards();
+    if (static_cast<int>(playfieldCards.size()) > kPackedMaxPlayfieldCards) return false;
+    if (static_cast<int>(stackCards.size()) > kPackedMaxStackCards) return false;
+
+    for (auto card : playfieldCards)
+    {
+        _playfieldCardIds.push_back(card->getId());
+        _playfieldFaces.push_back(static_cast<uint8_t>(card->getFace()));
+        _playfieldKeys.push_back(ZobristHash::playfieldKey(card->getId()));
+    }
+
+    // 备用牌堆最上面的牌在列表末尾，最先被抽取
+    for (auto it = stackCards.rbegin(); it != stackCards.rend(); ++it)
+    {
+        _stackCardIds.push_back((*it)->getId());
+        _stackFaces.push_back(static_cast<uint8_t>((*it)->getFace()));
+        _stackKeys.push_back(ZobristHash::stackKey((*it)->getId()));
+    }
+
+    // 卡牌ID在一局内从0连续分配，直接按ID下标建表
+    _cardIndexById.assign(gameModel->getCardCount(), -1);
+    for (size_t slot = 0; slot < _playfieldCardIds.size(); slot++)
+    {
+        _cardIndexById[_playfieldCardIds[slot]] = static_cast<int>(slot);
+    }
+    for (size_t index = 0; index < _stackCardIds.size(); index++)
+    {
+        _cardIndexById[_stackCardIds[index]] = getPlayfieldCount() + static_cast<int>(index);
+    }
+
+    _playfieldBlockerMasks.assign(playfieldCards.size() * 2, 0);
+    _playfieldCoverMasks.assign(playfieldCards.size() * 2, 0);
+    for (size_t slot = 0; slot < playfieldCards.size(); slot++)
+    {
+        for (int blockerId : gameModel->getCardBlockers(playfieldCards[slot]->getId()))
+        {
+            const int blockerSlot = findPlayfieldSlot(blockerId);
+            if (blockerSlot < 0) continue;
+            _playfieldBlockerMasks[slot * 2 + (blockerSlot >> 6)] |= 1ULL << (blockerSlot & 63);
+            _playfieldCoverMasks[blockerSlot * 2 + (slot >> 6)] |= 1ULL << (slot & 63);
+        }
+    }
+
+    _initialTrayCardId = gameModel->getTrayCard()->getId();
+    _initialTrayFace = gameModel->getTrayCard()->getFace();
+    return true;
+}
+
+int PackedGameLayout::findPlayfieldSlot(int cardId) const
+{
+    if (cardId < 0 || cardId >= static_cast<int>(_cardIndexById.size())) return -1;
+    const int cardIndex = _cardIndexById[cardId];
+    return cardIndex < getPlayfieldCount() ? cardIndex : -1;
+}
+
+int PackedGameLayout::findStackIndex(int cardId) const
+{
+    if (cardId < 0 || cardId >= static_cast<int>(_cardIndexById.size())) return -1;
+    const int cardIndex = _cardIndexById[cardId];
+    return cardIndex >= getPlayfieldCount() ? cardIndex - getPlayfieldCount() : -1;
+}
+
+int PackedGameLayout::getCardIdByIndex(int cardIndex) const
+{
+    if (cardIndex == kPackedInitialTrayIndex) return _initialTrayCardId;
+    if (cardIndex < getPlayfieldCount()) return _playfieldCardIds[cardIndex];
+    return _stackCardIds[cardIndex - getPlayfieldCount()];
+}
+
+PackedGameState PackedGameState::createInitial(const PackedGameLayout& layout)
+{
+    PackedGameState state;
+    state.playfieldMask[0] = 0;
+    state.playfieldMask[1] = 0;
+    for (int slot = 0; slot < layout.getPlayfieldCount(); slot++)
+    {
+        state.playfieldMask[slot >> 6] |= 1ULL << (slot & 63);
+    }
+    state.stackCursor = 0;
+    state.trayFace = static_cast<uint8_t>(layout.getInitialTrayFace());
+    state.trayCardIndex = kPackedInitialTrayIndex;
+    return state;
+}
+
+uint64_t PackedGameState::computeHash(const PackedGameLayout& layout) const
+{
+    uint64_t hash = ZobristHash::trayKey(trayFace);
+    for (int slot = 0; slot < layout.getPlayfieldCount(); slot++)
+    {
+        if (hasPlayfieldCard(slot)) hash ^= layout.getPlayfieldKey(slot);
+    }
+    for (int index = stackCursor; index < layout.getStackCount(); index++)
+    {
+        hash ^= layout.getStackKey(index);
+    }
+    return hash;
+}
+
+void PackedGameState::fillExposedFaces(const PackedGameLayout& layout, uint8_t* outFaces) const
+{
+    for (int slot = 0; slot < layout.getPlayfieldCount(); slot++)
+    {
+        outFaces[slot] = isPlayfieldCardExposed(layout, slot) ? static_cast<uint8_t>(layout.getPlayfieldFace(slot)) : CardMatchUtils::kNoFace;
+    }
+}
+
+bool PackedGameState::fromGameModel(const GameModel* gameModel, const PackedGameLayout& layout, PackedGameState& outState)
+{
+    if (!gameModel || !gameModel->getTrayCard()) return false;
+
+    PackedGameState state;
+    state.playfieldMask[0] = 0;
+    state.playfieldMask[1] = 0;
+
+    const auto& playfieldSlots = gameModel->getPlayfieldSlots();
+    for (size_t modelSlot = 0; modelSlot < playfieldSlots.size(); modelSlot++)
+    {
+        if (!gameModel->isPlayfieldSlotAlive(static_cast<int>(modelSlot))) continue;
+
+        int slot = layout.findPlayfieldSlot(playfieldSlots[modelSlot]->getId());
+        if (slot < 0) return false;
+        state.playfieldMask[slot >> 6] |= 1ULL << (slot & 63);
+    }
+
+    // 备用牌堆只会从顶部抽取，剩余的牌一定是抽取顺序的后缀
+    const auto& stackCards = gameModel->getStackCards();
+    const int drawn = layout.getStackCount() - static_cast<int>(stackCards.size());
+    if (drawn < 0) return false;
+    for (size_t i = 0; i < stackCards.size(); i++)
+    {
+        if (layout.findStackIndex(stackCards[i]->getId()) != layout.getStackCount() - 1 - static_cast<int>(i))
+        {
+            return false;
+        }
+    }
+    state.stackCursor = static_cast<uint8_t>(drawn);
+
+    const CardModel* trayCard = gameModel->getTrayCard();
+    state.trayFace = static_cast<uint8_t>(trayCard->getFace());
+    if (trayCard->getId() == layout.getInitialTrayCardId())
+    {
+        state.trayCardIndex = kPackedInitialTrayIndex;
+    }
+    else if (layout.findPlayfieldSlot(trayCard->getId()) >= 0)
+    {
+        state.trayCardIndex = static_cast<int16_t>(layout.findPlayfieldSlot(trayCard->getId()));
+    }
+    else if (layout.findStackIndex(trayCard->getId()) >= 0)
+    {
+        state.trayCardIndex = static_cast<int16_t>(layout.getPlayfieldCount() + layout.findStackIndex(trayCard->getId()));
+    }
+    else
+    {
+        return false;
+    }
+
+    outState = state;
+    return true;
+}
+
+bool PackedGameState::applyToGameModel(GameModel* gameModel, const PackedGameLayout& layout) const
+{
+    if (!gameModel) return false;
+
+    // 先确认所有卡牌都存在，避免写回一半失败
+    CardModel* trayCard = gameModel->findCardById(layout.getCardIdByIndex(trayCardIndex));
+    if (!trayCard) return false;
+    for (int slot = 0; slot < layout.getPlayfieldCount(); slot++)
+    {
+        if (!gameModel->findCardById(layout.getPlayfieldCardId(slot))) return false;
+    }
+    for (int index = 0; index < layout.getStackCount(); index++)
+    {
+        if (!gameModel->findCardById(layout.getStackCardId(index))) return false;
+    }
+
+    // 通过模型接口增删卡牌，保证局面哈希同步更新；主牌区只切换存活位，槽位顺序不变
+    const auto& playfieldSlots = gameModel->getPlayfieldSlots();
+    for (size_t modelSlot = 0; modelSlot < playfieldSlots.size(); modelSlot++)
+    {
+        if (layout.findPlayfieldSlot(playfieldSlots[modelSlot]->getId()) < 0)
+        {
+            gameModel->removePlayfieldCard(playfieldSlots[modelSlot]);
+        }
+    }
+    for (int slot = 0; slot < layout.getPlayfieldCount(); slot++)
+    {
+        CardModel* card = gameModel->findCardById(layout.getPlayfieldCardId(slot));
+        if (hasPlayfieldCard(slot))
+        {
+            gameModel->addPlayfieldCard(card);
+        }
+        else
+        {
+            gameModel->removePlayfieldCard(card);
+        }
+    }
+
+    // 下一张要抽取的牌放在列表末尾
+    const auto& stackCards = gameModel->getStackCards();
+    while (!stackCards.empty())
+    {
+        gameModel->removeStackCard(stackCards.back());
+    }
+    for (int index = layout.getStackCount() - 1; index >= stackCursor; index--)
+    {
+        gameModel->addStackCard(gameModel->findCardById(layout.getStackCardId(index)));
+    }
+
+    gameModel->setTrayCard(trayCard);
+    gameModel->updateBlockedCards();
+    return true;
+}
@@ -0,0 +1,252 @@
+#ifndef __PACKED_GAME_STATE_H__
+#define __PACKED_GAME_STATE_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class GameModel;
+
+/**
+ * @brief 紧凑局面支持的主牌区卡牌数量上限（两个64位掩码）
+ */
+const int kPackedMaxPlayfieldCards = 128;
+
+/**
+ * @brief 紧凑局面支持的备用牌堆卡牌数量上限
+ */
+const int kPackedMaxStackCards = 255;
+
+/**
+ * @brief 初始底牌在紧凑局面中的卡牌下标
+ */
+const int kPackedInitialTrayIndex = -1;
+
+/**
+ * @brief 关卡布局
+ * 记录一局开始时主牌区每个槽位和备用牌堆每张牌对应的卡牌ID与点数
+ * 整局不变，所有PackedGameState共享同一份布局
+ */
+class PackedGameLayout
+{
+public:
+    PackedGameLayout();
+
+    /**
+     * @brief 从开局时的游戏数据模型构建布局
+     * 主牌区槽位顺序为当前主牌区列表顺序，备用牌堆按抽取顺序（从最上面的牌开始）
+     * 遮挡关系取自GameModel::getCardBlockers，已不在主牌区的遮挡者忽略
+     * @param gameModel 游戏数据模型
+     * @return 构建成功返回true，卡牌数量超出上限或没有底牌返回false
+     */
+    bool buildFromGameModel(const GameModel* gameModel);
+
+    /**
+     * @brief 获取主牌区槽位数量
+     */
+    int getPlayfieldCount() const { return static_cast<int>(_playfieldCardIds.size()); }
+
+    /**
+     * @brief 获取备用牌堆卡牌数量（不含初始底牌）
+     */
+    int getStackCount() const { return static_cast<int>(_stackCardIds.size()); }
+
+    /**
+     * @brief 获取主牌区槽位的卡牌ID/点数
+     * @param slot 槽位下标
+     */
+    int getPlayfieldCardId(int slot) const { return _playfieldCardIds[slot]; }
+    int getPlayfieldFace(int slot) const { return _playfieldFaces[slot]; }
+
+    /**
+     * @brief 获取备用牌堆第index次抽取的卡牌ID/点数
+     * @param index 抽取顺序下标
+     */
+    int getStackCardId(int index) const { return _stackCardIds[index]; }
+    int getStackFace(int index) const { return _stackFaces[index]; }
+
+    /**
+     * @brief 获取主牌区槽位/备用牌的Zobrist键（与GameModel::getHash使用同一套键）
+     */
+    uint64_t getPlayfieldKey(int slot) const { return _playfieldKeys[slot]; }
+    uint64_t getStackKey(int index) const { return _stackKeys[index]; }
+
+    /**
+     * @brief 获取主牌区槽位的遮挡掩码（两个64位字）
+     * Blocker为直接压在该槽位上的槽位，Cover为被该槽位直接压住的槽位
+     * @param slot 槽位下标
+     */
+    const uint64_t* getPlayfieldBlockerMask(int slot) const { return &_playfieldBlockerMasks[slot * 2]; }
+    const uint64_t* getPlayfieldCoverMask(int slot) const { return &_playfieldCoverMasks[slot * 2]; }
+
+    /**
+     * @brief 获取初始底牌的卡牌ID/点数
+     */
+    int getInitialTrayCardId() const { return _initialTrayCardId; }
+    int getInitialTrayFace() const { return _initialTrayFace; }
+
+    /**
+     * @brief 根据卡牌ID查找主牌区槽位
+     * @param cardId 卡牌ID
+     * @return 槽位下标，不在主牌区返回-1
+     */
+    int findPlayfieldSlot(int cardId) const;
+
+    /**
+     * @brief 根据卡牌ID查找备用牌堆抽取顺序下标
+     * @param cardId 卡牌ID
+     * @return 抽取顺序下标，不在备用牌堆返回-1
+     */
+    int findStackIndex(int cardId) const;
+
+    /**
+     * @brief 获取紧凑局面中卡牌下标对应的卡牌ID
+     * @param cardIndex 主牌区槽位为[0, P)，备用牌为[P, P+S)，初始底牌为kPackedInitialTrayIndex
+     * @return 卡牌ID
+     */
+    int getCardIdByIndex(int cardIndex) const;
+
+private:
+    std::vector<int> _playfieldCardIds;     // 主牌区槽位对应的卡牌ID
+    std::vector<uint8_t> _playfieldFaces;   // 主牌区槽位对应的点数
+    std::vector<int> _stackCardIds;         // 备用牌按抽取顺序对应的卡牌ID
+    std::vector<uint8_t> _stackFaces;       // 备用牌按抽取顺序对应的点数
+    std::vector<uint64_t> _playfieldKeys;   // 主牌区槽位的Zobrist键
+    std::vector<uint64_t> _stackKeys;       // 备用牌的Zobrist键
+    std::vector<uint64_t> _playfieldBlockerMasks;   // 每个槽位的遮挡者掩码，每槽位两个字
+    std::vector<uint64_t> _playfieldCoverMasks;     // 每个槽位压住的槽位掩码，每槽位两个字
+    std::vector<int> _cardIndexById;        // 卡牌ID到卡牌下标的映射（主牌区为槽位，备用牌为P+抽取顺序），不在布局中为-1
+    int _initialTrayCardId;                 // 初始底牌ID
+    int _initialTrayFace;                   // 初始底牌点数
+};
+
+/**
+ * @brief 紧凑的游戏局面
+ * 可平凡拷贝，用于搜索、模拟和回放中大量复制与比较局面
+ * 卡牌的ID和点数保存在PackedGameLayout中，局面本身只记录哪些牌还在
+ */
+struct PackedGameState
+{
+    uint64_t playfieldMask[2];  // 仍在主牌区的卡牌（按槽位）
+    uint8_t stackCursor;        // 已从备用牌堆抽取的数量
+    uint8_t trayFace;           // 当前底牌点数
+    int16_t trayCardIndex;      // 当前底牌的卡牌下标，仅用于还原GameModel，不参与局面比较
+
+    /**
+     * @brief 创建开局局面
+     * @param layout 关卡布局
+     */
+    static PackedGameState createInitial(const PackedGameLayout& layout);
+
+    /**
+     * @brief 从游戏数据模型读取局面
+     * @param gameModel 游戏数据模型
+     * @param layout 该局的关卡布局
+     * @param outState 输出参数，保存读取的局面
+     * @return 模型中的卡牌都能在布局中找到返回true
+     */
+    static bool fromGameModel(const GameModel* gameModel, const PackedGameLayout& layout, PackedGameState& outState);
+
+    /**
+     * @brief 将局面写回游戏数据模型
+     * 按布局顺序重建主牌区、备用牌堆和底牌，模型中须包含布局中的所有卡牌
+     * @param gameModel 游戏数据模型
+     * @param layout 该局的关卡布局
+     * @return 写回成功返回true
+     */
+    bool applyToGameModel(GameModel* gameModel, const PackedGameLayout& layout) const;
+
+    /**
+     * @brief 计算局面的Zobrist哈希
+     * 与同一局面下GameModel::getHash的结果相同，搜索中可改为增量更新
+     * @param layout 该局的关卡布局
+     * @return 局面哈希
+     */
+    uint64_t computeHash(const PackedGameLayout& layout) const;
+
+    /**
+     * @brief 填充可点击点数数组，供CardMatchUtils::getLegalMoveMask一次生成所有走法
+     * @param layout 该局的关卡布局
+     * @param outFaces 输出数组，至少layout.getPlayfieldCount()个元素，已移除或被遮挡的槽位为CardMatchUtils::kNoFace
+     */
+    void fillExposedFaces(const PackedGameLayout& layout, uint8_t* outFaces) const;
+
+    /**
+     * @brief 主牌区槽位上的卡牌是否还在且没有被遮挡
+     */
+    bool isPlayfieldCardExposed(const PackedGameLayout& layout, int slot) const
+    {
+        const uint64_t* blockers = layout.getPlayfieldBlockerMask(slot);
+        return hasPlayfieldCard(slot)
+            && ((blockers[0] & playfieldMask[0]) | (blockers[1] & playfieldMask[1])) == 0;
+    }
+
+    /**
+     * @brief 主牌区槽位上的卡牌是否还压着其他牌
+     */
+    bool isPlayfieldCardCovering(const PackedGameLayout& layout, int slot) const
+    {
+        const uint64_t* covers = layout.getPlayfieldCoverMask(slot);
+        return ((covers[0] & playfieldMask[0]) | (covers[1] & playfieldMask[1])) != 0;
+    }
+
+    /**
+     * @brief 主牌区槽位上的卡牌是否还在
+     */
+    bool hasPlayfieldCard(int slot) const { return (playfieldMask[slot >> 6] >> (slot & 63)) & 1; }
+
+    /**
+     * @brief 主牌区是否已清空
+     */
+    bool isPlayfieldEmpty() const { return (playfieldMask[0] | playfieldMask[1]) == 0; }
+
+    /**
+     * @brief 将主牌区槽位上的卡牌移动到底牌
+     * @param slot 槽位下标
+     * @param face 该卡牌点数
+     */
+    void movePlayfieldCardToTray(int slot, int face)
+    {
+        playfieldMask[slot >> 6] &= ~(1ULL << (slot & 63));
+        trayFace = static_cast<uint8_t>(face);
+        trayCardIndex = static_cast<int16_t>(slot);
+    }
+
+    /**
+     * @brief 将备用牌堆最上面的牌移动到底牌
+     * @param layout 关卡布局
+     */
+    void moveStackCardToTray(const PackedGameLayout& layout)
+    {
+        trayFace = static_cast<uint8_t>(layout.getStackFace(stackCursor));
+        trayCardIndex = static_cast<int16_t>(layout.getPlayfieldCount() + stackCursor);
+        stackCursor++;
+    }
+
+    bool operator==(const PackedGameState& other) const
+    {
+        return playfieldMask[0] == other.playfieldMask[0]
+            && playfieldMask[1] == other.playfieldMask[1]
+            && stackCursor == other.stackCursor
+            && trayFace == other.trayFace;
+    }
+
+    bool operator!=(const PackedGameState& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief PackedGameState的哈希函数，可用于unordered容器
+ */
+struct PackedGameStateHash
+{
+    size_t operator()(const PackedGameState& state) const
+    {
+        uint64_t h = state.playfieldMask[0] * 0x9E3779B97F4A7C15ULL;
+        h ^= state.playfieldMask[1] + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= (static_cast<uint64_t>(state.stackCursor) << 8) | state.trayFace;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+};
+
+#endif // __PACKED_GAME_STATE_H__
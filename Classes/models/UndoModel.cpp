@@ -1,21 +1,25 @@
 #include "UndoModel.h"
+#include <type_traits>
+
+static_assert(sizeof(UndoModel) == 4, "UndoModel must stay 4 bytes");
+static_assert(std::is_trivially_copyable<UndoModel>::value, "UndoModel must stay trivially copyable");
+
+const int UndoModel::kMaxIndex;
 
 UndoModel::UndoModel()
-    : _actionType(UAT_NONE)
-    , _cardId(0)
-    , _previousTrayCardId(0)
-    , _originalPosition(cocos2d::Vec2::ZERO)
+    : _packed(UAT_NONE)
 {
 }
 
-UndoModel::UndoModel(UndoActionType type, int cardId, int previousTrayCardId, const cocos2d::Vec2& originalPos)
-    : _actionType(type)
-    , _cardId(cardId)
-    , _previousTrayCardId(previousTrayCardId)
-    , _originalPosition(originalPos)
+UndoModel::UndoModel(UndoActionType type, int sourceIndex, int previousTrayCardId)
+    : _packed(UAT_NONE)
 {
-}
+    // 截断会让撤销找到另一张牌，超出范围时保持无效记录
+    if (type != UAT_PLAYFIELD_TO_TRAY && type != UAT_STACK_TO_TRAY) return;
+    if (sourceIndex < 0 || sourceIndex > kMaxIndex) return;
+    if (previousTrayCardId < 0 || previousTrayCardId > kMaxIndex) return;
 
-UndoModel::~UndoModel()
-{
+    _packed = static_cast<uint32_t>(type)
+            | (static_cast<uint32_t>(sourceIndex) << 2)
+            | (static_cast<uint32_t>(previousTrayCardId) << 17);
 }
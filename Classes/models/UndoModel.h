@@ -1,7 +1,7 @@
 #ifndef __UNDO_MODEL_H__
 #define __UNDO_MODEL_H__
 
-#include "cocos2d.h"
+#include <cstdint>
 
 /**
  * @brief 撤销操作类型枚举
@@ -15,68 +15,51 @@ enum UndoActionType
 
 /**
  * @brief 撤销操作数据模型
- * 记录一次操作的所有必要信息，用于撤销该操作
+ * 记录一次操作的所有必要信息，用于撤销和重做该操作
+ * 压缩在一个32位字中：操作类型2位，来源下标15位，之前的底牌ID 15位
+ * 被移动的卡牌就是操作后的底牌，卡牌原始位置保存在CardModel中（来自关卡配置），都不需要记录
+ * 备用牌堆的牌撤销时总是回到牌堆顶部，不记录来源下标
+ * 下标和ID超出15位时构造出无效记录，不会截断成其他卡牌；加载关卡时已限制卡牌数量（见kLevelMaxCardCount）
  */
 class UndoModel
 {
 public:
-    UndoModel();
-    UndoModel(UndoActionType type, int cardId, int previousTrayCardId, const cocos2d::Vec2& originalPos);
-    ~UndoModel();
-
-    /**
-     * @brief 获取撤销操作类型
-     * @return 操作类型
-     */
-    UndoActionType getActionType() const { return _actionType; }
+    static const int kMaxIndex = 0x7FFF;    // 来源下标和底牌ID的最大值
 
-    /**
-     * @brief 获取移动的卡牌ID
-     * @return 卡牌ID
-     */
-    int getCardId() const { return _cardId; }
-
-    /**
-     * @brief 获取之前的底牌ID
-     * @return 之前底牌的ID
-     */
-    int getPreviousTrayCardId() const { return _previousTrayCardId; }
+    UndoModel();
 
     /**
-     * @brief 获取卡牌原始位置
-     * @return 原始位置坐标
+     * @param type 操作类型
+     * @param sourceIndex 来源下标：主牌区为卡牌槽位，备用牌堆不使用，传0
+     * @param previousTrayCardId 之前的底牌ID
      */
-    const cocos2d::Vec2& getOriginalPosition() const { return _originalPosition; }
+    UndoModel(UndoActionType type, int sourceIndex, int previousTrayCardId);
 
     /**
-     * @brief 设置撤销操作类型
-     * @param type 操作类型
+     * @brief 判断是否为有效记录，参数超出范围时构造的记录无效
      */
-    void setActionType(UndoActionType type) { _actionType = type; }
+    bool isValid() const { return getActionType() != UAT_NONE; }
 
     /**
-     * @brief 设置移动的卡牌ID
-     * @param cardId 卡牌ID
+     * @brief 获取撤销操作类型
+     * @return 操作类型
      */
-    void setCardId(int cardId) { _cardId = cardId; }
+    UndoActionType getActionType() const { return static_cast<UndoActionType>(_packed & 0x3); }
 
     /**
-     * @brief 设置之前的底牌ID
-     * @param cardId 之前底牌的ID
+     * @brief 获取来源下标
+     * @return 主牌区为卡牌槽位，备用牌堆为0
      */
-    void setPreviousTrayCardId(int cardId) { _previousTrayCardId = cardId; }
+    int getSourceIndex() const { return static_cast<int>((_packed >> 2) & kMaxIndex); }
 
     /**
-     * @brief 设置卡牌原始位置
-     * @param position 原始位置坐标
+     * @brief 获取之前的底牌ID
+     * @return 之前底牌的ID
      */
-    void setOriginalPosition(const cocos2d::Vec2& position) { _originalPosition = position; }
+    int getPreviousTrayCardId() const { return static_cast<int>((_packed >> 17) & kMaxIndex); }
 
 private:
-    UndoActionType _actionType;         // 操作类型
-    int _cardId;                        // 移动的卡牌ID
-    int _previousTrayCardId;            // 之前的底牌ID
-    cocos2d::Vec2 _originalPosition;    // 卡牌原始位置
+    uint32_t _packed;   // 操作类型 | 来源下标 << 2 | 之前的底牌ID << 17
 };
 
 #endif // __UNDO_MODEL_H__
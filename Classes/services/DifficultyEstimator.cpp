@@ -0,0 +1,400 @@
+#include "DifficultyEstimator.h"
+#include "GameModelGenerator.h"
+#include "../configs/models/LevelConfig.h"
+#include "../models/GameModel.h"
+#include "../models/CardModel.h"
+#include "../models/PackedGameState.h"
+#include "../utils/WorkStealingPool.h"
+#include <mutex>
+
+namespace
+{
+    const int kFaces = CFT_NUM_CARD_FACE_TYPES;
+    const long long kPlayoutsPerChunk = 4096;   // 每个任务模拟的局数，每个任务使用独立的随机数序列
+
+    /**
+     * @brief 统计位掩码中1的个数
+     */
+    inline int countBits(uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(bits);
+#else
+        int count = 0;
+        while (bits)
+        {
+            bits &= bits - 1;
+            count++;
+        }
+        return count;
+#endif
+    }
+
+    /**
+     * @brief 获取最低位1的下标（bits不为0）
+     */
+    inline int lowestBitIndex(uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int index = 0;
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    /**
+     * @brief 获取两字掩码中第n个1所在的槽位
+     */
+    inline int selectBit(const uint64_t* mask, int n)
+    {
+        uint64_t bits = mask[0];
+        int offset = 0;
+        const int lowCount = countBits(bits);
+        if (n >= lowCount)
+        {
+            n -= lowCount;
+            bits = mask[1];
+            offset = 64;
+        }
+        while (n-- > 0) bits &= bits - 1;
+        return offset + lowestBitIndex(bits);
+    }
+
+    /**
+     * @brief 模拟对局用的随机数生成器（xorshift64*）
+     * 每个任务独立一份，不需要同步
+     */
+    class PlayoutRandom
+    {
+    public:
+        /**
+         * @param seed 全局种子
+         * @param stream 随机数序列编号，不同编号得到互不相关的序列
+         */
+        PlayoutRandom(uint64_t seed, uint64_t stream)
+        {
+            // splitmix64打散种子，保证状态不为0
+            uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            _state = (z ^ (z >> 31)) | 1;
+        }
+
+        uint64_t next()
+        {
+            _state ^= _state >> 12;
+            _state ^= _state << 25;
+            _state ^= _state >> 27;
+            return _state * 0x2545F4914F6CDD1DULL;
+        }
+
+        /**
+         * @brief 获取[0, bound)内的随机整数
+         */
+        int nextInt(int bound)
+        {
+            return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+        }
+
+    private:
+        uint64_t _state;
+    };
+
+    /**
+     * @brief 模拟对局的开局数据，所有任务只读共享
+     */
+    struct PlayoutBoard
+    {
+        int playfieldCount;
+        int stackCount;
+        int initialTrayFace;
+        uint8_t playfieldFaces[kPackedMaxPlayfieldCards];
+        uint8_t stackFaces[kPackedMaxStackCards];
+        uint64_t blockerMasks[kPackedMaxPlayfieldCards][2];
+        uint64_t coverMasks[kPackedMaxPlayfieldCards][2];
+        uint64_t initialPresent[2];
+        uint64_t initialExposedByFace[kFaces][2];  // 开局时每种点数可点击的槽位
+
+        void build(const PackedGameLayout& layout)
+        {
+            playfieldCount = layout.getPlayfieldCount();
+            stackCount = layout.getStackCount();
+            initialTrayFace = layout.getInitialTrayFace();
+
+            PackedGameState state = PackedGameState::createInitial(layout);
+            initialPresent[0] = state.playfieldMask[0];
+            initialPresent[1] = state.playfieldMask[1];
+            for (int face = 0; face < kFaces; face++)
+            {
+                initialExposedByFace[face][0] = 0;
+                initialExposedByFace[face][1] = 0;
+            }
+
+            for (int slot = 0; slot < playfieldCount; slot++)
+            {
+                playfieldFaces[slot] = static_cast<uint8_t>(layout.getPlayfieldFace(slot));
+                for (int word = 0; word < 2; word++)
+                {
+                    blockerMasks[slot][word] = layout.getPlayfieldBlockerMask(slot)[word];
+                    coverMasks[slot][word] = layout.getPlayfieldCoverMask(slot)[word];
+                }
+                if (state.isPlayfieldCardExposed(layout, slot))
+                {
+                    initialExposedByFace[playfieldFaces[slot]][slot >> 6] |= 1ULL << (slot & 63);
+                }
+            }
+            for (int index = 0; index < stackCount; index++)
+            {
+                stackFaces[index] = static_cast<uint8_t>(layout.getStackFace(index));
+            }
+        }
+    };
+
+    /**
+     * @brief 执行单局模拟
+     * 局面只保存在几个位掩码中：仍在主牌区的槽位，以及按点数分桶的可点击槽位
+     * 可消除的牌为底牌相邻两个点数桶的并集，不需要遍历主牌区
+     */
+    class PlayoutRunner
+    {
+    public:
+        PlayoutRunner(const PlayoutBoard& board, PlayoutPolicyType policy)
+            : _board(board)
+            , _policy(policy)
+        {
+        }
+
+        /**
+         * @brief 模拟一局并把结果计入report
+         */
+        void run(PlayoutRandom& random, DifficultyReport& report)
+        {
+            reset();
+
+            while (_remaining > 0)
+            {
+                const int lowFace = (_trayFace + kFaces - 1) % kFaces;
+                const int highFace = (_trayFace + 1) % kFaces;
+                uint64_t legal[2] = {
+                    _exposedByFace[lowFace][0] | _exposedByFace[highFace][0],
+                    _exposedByFace[lowFace][1] | _exposedByFace[highFace][1]
+                };
+                const int legalCount = countBits(legal[0]) + countBits(legal[1]);
+                const bool canDraw = _stackCursor < _board.stackCount;
+                if (legalCount == 0 && !canDraw) break;
+
+                if (legalCount == 0)
+                {
+                    drawStackCard();
+                    continue;
+                }
+
+                switch (_policy)
+                {
+                case PPT_RANDOM:
+                {
+                    const int choice = random.nextInt(legalCount + (canDraw ? 1 : 0));
+                    if (choice < legalCount)
+                    {
+                        removePlayfieldCard(selectBit(legal, choice));
+                    }
+                    else
+                    {
+                        drawStackCard();
+                    }
+                    break;
+                }
+                case PPT_GREEDY_TRAY_MATCH:
+                {
+                    // 消除后新底牌为该点数，比较两个候选点数消除后可匹配的牌数，没有可点击牌的点数得分为-1
+                    const int lowScore = scoreFace(lowFace);
+                    const int highScore = scoreFace(highFace);
+                    int face = lowScore > highScore ? lowFace : highFace;
+                    if (lowScore == highScore) face = random.nextInt(2) ? lowFace : highFace;
+
+                    const uint64_t* candidates = _exposedByFace[face];
+                    removePlayfieldCard(selectBit(candidates, random.nextInt(countBits(candidates[0]) + countBits(candidates[1]))));
+                    break;
+                }
+                default:
+                    removePlayfieldCard(selectBit(legal, random.nextInt(legalCount)));
+                    break;
+                }
+            }
+
+            report.playouts++;
+            if (_remaining == 0) report.wins++;
+            report.totalStackDraws += _stackCursor;
+            report.remainingHistogram[_remaining]++;
+        }
+
+    private:
+        void reset()
+        {
+            _present[0] = _board.initialPresent[0];
+            _present[1] = _board.initialPresent[1];
+            for (int face = 0; face < kFaces; face++)
+            {
+                _exposedByFace[face][0] = _board.initialExposedByFace[face][0];
+                _exposedByFace[face][1] = _board.initialExposedByFace[face][1];
+            }
+            _stackCursor = 0;
+            _trayFace = _board.initialTrayFace;
+            _remaining = _board.playfieldCount;
+        }
+
+        /**
+         * @brief 候选点数的得分：该点数的牌没有可点击的返回-1，否则为成为底牌后可匹配的牌数
+         */
+        int scoreFace(int face) const
+        {
+            if ((_exposedByFace[face][0] | _exposedByFace[face][1]) == 0) return -1;
+            const int lowFace = (face + kFaces - 1) % kFaces;
+            const int highFace = (face + 1) % kFaces;
+            return countBits(_exposedByFace[lowFace][0] | _exposedByFace[highFace][0])
+                 + countBits(_exposedByFace[lowFace][1] | _exposedByFace[highFace][1]);
+        }
+
+        void removePlayfieldCard(int slot)
+        {
+            const uint64_t bit = 1ULL << (slot & 63);
+            const int face = _board.playfieldFaces[slot];
+            _present[slot >> 6] &= ~bit;
+            _exposedByFace[face][slot >> 6] &= ~bit;
+            _trayFace = face;
+            _remaining--;
+
+            // 只有被它直接压住的牌可能露出
+            for (int word = 0; word < 2; word++)
+            {
+                uint64_t bits = _board.coverMasks[slot][word];
+                while (bits)
+                {
+                    const int covered = word * 64 + lowestBitIndex(bits);
+                    bits &= bits - 1;
+                    const uint64_t* blockers = _board.blockerMasks[covered];
+                    if (((blockers[0] & _present[0]) | (blockers[1] & _present[1])) == 0)
+                    {
+                        _exposedByFace[_board.playfieldFaces[covered]][covered >> 6] |= 1ULL << (covered & 63);
+                    }
+                }
+            }
+        }
+
+        void drawStackCard()
+        {
+            _trayFace = _board.stackFaces[_stackCursor++];
+        }
+
+        const PlayoutBoard& _board;
+        PlayoutPolicyType _policy;
+        uint64_t _present[2];                   // 仍在主牌区的槽位
+        uint64_t _exposedByFace[kFaces][2];     // 每种点数可点击的槽位
+        int _stackCursor;                       // 已抽牌数量
+        int _trayFace;                          // 当前底牌点数
+        int _remaining;                         // 主牌区剩余卡牌数
+    };
+
+    /**
+     * @brief 合并两份评估结果
+     */
+    void mergeReport(DifficultyReport& target, const DifficultyReport& source)
+    {
+        target.playouts += source.playouts;
+        target.wins += source.wins;
+        target.totalStackDraws += source.totalStackDraws;
+        for (size_t i = 0; i < source.remainingHistogram.size(); i++)
+        {
+            target.remainingHistogram[i] += source.remainingHistogram[i];
+        }
+    }
+}
+
+double DifficultyReport::getAverageRemainingCards() const
+{
+    if (playouts <= 0) return 0.0;
+
+    long long total = 0;
+    for (size_t remaining = 0; remaining < remainingHistogram.size(); remaining++)
+    {
+        total += remainingHistogram[remaining] * static_cast<long long>(remaining);
+    }
+    return static_cast<double>(total) / playouts;
+}
+
+bool DifficultyEstimator::estimate(const LevelConfig* levelConfig, PlayoutPolicyType policy, long long playoutCount,
+                                   int threadCount, uint64_t seed, DifficultyReport& outReport)
+{
+    outReport = DifficultyReport();
+    if (!levelConfig) return false;
+
+    GameModel* gameModel = GameModelGenerator::generateFromLevelConfig(levelConfig);
+    if (!gameModel) return false;
+
+    bool succeeded = estimate(gameModel, policy, playoutCount, threadCount, seed, outReport);
+    delete gameModel;
+    return succeeded;
+}
+
+bool DifficultyEstimator::estimate(const GameModel* gameModel, PlayoutPolicyType policy, long long playoutCount,
+                                   int threadCount, uint64_t seed, DifficultyReport& outReport)
+{
+    outReport = DifficultyReport();
+    outReport.policy = policy;
+
+    PackedGameLayout layout;
+    if (!layout.buildFromGameModel(gameModel)) return false;
+
+    PlayoutBoard board;
+    board.build(layout);
+    outReport.remainingHistogram.assign(board.playfieldCount + 1, 0);
+    if (playoutCount <= 0) return true;
+
+    // 按固定大小切分任务，每个任务用自己的随机数序列，结果只取决于种子和局数
+    std::mutex reportMutex;
+    WorkStealingPool pool(threadCount);
+    const long long chunkCount = (playoutCount + kPlayoutsPerChunk - 1) / kPlayoutsPerChunk;
+    for (long long chunk = 0; chunk < chunkCount; chunk++)
+    {
+        const long long begin = chunk * kPlayoutsPerChunk;
+        const long long count = playoutCount - begin < kPlayoutsPerChunk ? playoutCount - begin : kPlayoutsPerChunk;
+        pool.submit([&board, &outReport, &reportMutex, policy, seed, chunk, count]() {
+            DifficultyReport localReport;
+            localReport.remainingHistogram.assign(board.playfieldCount + 1, 0);
+
+            PlayoutRandom random(seed, static_cast<uint64_t>(chunk));
+            PlayoutRunner runner(board, policy);
+            for (long long i = 0; i < count; i++)
+            {
+                runner.run(random, localReport);
+            }
+
+            std::lock_guard<std::mutex> lock(reportMutex);
+            mergeReport(outReport, localReport);
+        });
+    }
+    pool.waitIdle();
+
+    return true;
+}
+
+const char* DifficultyEstimator::getPolicyName(PlayoutPolicyType policy)
+{
+    switch (policy)
+    {
+    case PPT_RANDOM:
+        return "random";
+    case PPT_GREEDY_TRAY_MATCH:
+        return "greedy";
+    case PPT_PREFER_PLAYFIELD:
+        return "playfield";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef __DIFFICULTY_ESTIMATOR_H__
+#define __DIFFICULTY_ESTIMATOR_H__
+
+#include <cstdint>
+#include <vector>
+
+class LevelConfig;
+class GameModel;
+
+/**
+ * @brief 模拟对局使用的出牌策略
+ */
+enum PlayoutPolicyType
+{
+    PPT_RANDOM,             // 在所有合法操作（含抽牌）中均匀随机选择
+    PPT_GREEDY_TRAY_MATCH,  // 优先消除主牌区，选择让新底牌可匹配的牌最多的点数
+    PPT_PREFER_PLAYFIELD,   // 优先随机消除主牌区，无牌可消时才抽牌
+    PPT_NUM_POLICY_TYPES
+};
+
+/**
+ * @brief 难度评估结果
+ */
+struct DifficultyReport
+{
+    PlayoutPolicyType policy;                   // 使用的出牌策略
+    long long playouts;                         // 模拟局数
+    long long wins;                             // 通关局数
+    long long totalStackDraws;                  // 所有对局从备用牌堆抽牌的总次数
+    std::vector<long long> remainingHistogram;  // 下标为结束时主牌区剩余卡牌数，值为局数
+
+    DifficultyReport() : policy(PPT_RANDOM), playouts(0), wins(0), totalStackDraws(0) {}
+
+    /**
+     * @brief 获取通关率
+     */
+    double getWinRate() const { return playouts > 0 ? static_cast<double>(wins) / playouts : 0.0; }
+
+    /**
+     * @brief 获取每局平均抽牌次数
+     */
+    double getAverageStackDraws() const { return playouts > 0 ? static_cast<double>(totalStackDraws) / playouts : 0.0; }
+
+    /**
+     * @brief 获取每局结束时主牌区平均剩余卡牌数
+     */
+    double getAverageRemainingCards() const;
+};
+
+/**
+ * @brief 关卡难度评估服务
+ * 用指定策略对关卡做大量随机模拟对局（蒙特卡洛），统计通关率、剩余卡牌分布和抽牌次数
+ * 模拟在紧凑局面上进行，按点数分桶的位掩码使每步走法生成为O(1)
+ * 这是一个无状态的服务类，不持有数据，通过参数操作或返回数据
+ */
+class DifficultyEstimator
+{
+public:
+    /**
+     * @brief 评估关卡配置的难度
+     * @param levelConfig 关卡配置对象
+     * @param policy 出牌策略
+     * @param playoutCount 模拟局数
+     * @param threadCount 线程数量，小于1时使用硬件线程数
+     * @param seed 随机种子，种子和局数相同时结果与线程数量无关
+     * @param outReport 输出参数，保存评估结果
+     * @return 评估成功返回true，关卡无法生成或超出紧凑局面上限返回false
+     */
+    static bool estimate(const LevelConfig* levelConfig, PlayoutPolicyType policy, long long playoutCount,
+                         int threadCount, uint64_t seed, DifficultyReport& outReport);
+
+    /**
+     * @brief 从当前游戏局面开始评估难度
+     * @param gameModel 游戏数据模型（只读，不会被修改）
+     * @param policy 出牌策略
+     * @param playoutCount 模拟局数
+     * @param threadCount 线程数量，小于1时使用硬件线程数
+     * @param seed 随机种子
+     * @param outReport 输出参数，保存评估结果
+     * @return 评估成功返回true
+     */
+    static bool estimate(const GameModel* gameModel, PlayoutPolicyType policy, long long playoutCount,
+                         int threadCount, uint64_t seed, DifficultyReport& outReport);
+
+    /**
+     * @brief 获取策略名称
+     * @param policy 出牌策略
+     * @return 策略名称（random/greedy/playfield）
+     */
+    static const char* getPolicyName(PlayoutPolicyType policy);
+};
+
+#endif // __DIFFICULTY_ESTIMATOR_H__
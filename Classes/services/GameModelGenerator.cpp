@@ -1,54 +1,156 @@
 #include "GameModelGenerator.h"
 #include "../configs/models/LevelConfig.h"
+#include "../configs/models/CompiledLevel.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
+#include "../utils/CardOcclusionUtils.h"
+#include "../utils/TraceUtils.h"
 
-int GameModelGenerator::s_nextCardId = 1;
+static_assert(kLevelMaxCardCount == GameModel::kMaxCardCount, "level card limit must match the undo record fields");
 
 GameModel* GameModelGenerator::generateFromLevelConfig(const LevelConfig* levelConfig)
 {
+    GAME_TRACE_SCOPE("generateGameModel");
     if (!levelConfig) return nullptr;
 
+    // 本局所有卡牌一次分配，卡牌数量超出上限时拒绝生成
+    const auto& playfieldCards = levelConfig->getPlayfieldCards();
+    const auto& stackCards = levelConfig->getStackCards();
+    if (playfieldCards.size() + stackCards.size() > static_cast<size_t>(GameModel::kMaxCardCount)) return nullptr;
+
     GameModel* gameModel = new GameModel();
+    gameModel->reserveCards(static_cast<int>(playfieldCards.size() + stackCards.size()));
 
-    // 生成主牌区卡牌
-    const auto& playfieldCards = levelConfig->getPlayfieldCards();
-    for (const auto& cardData : playfieldCards)
+    // 配置层级相同时靠后的牌在上层，合成唯一的绘制层级，撤销后重新加入的牌也能回到原来的层次
+    const std::vector<int> drawRank = CardOcclusionUtils::computeDrawRanks(playfieldCards);
+
+    std::vector<int> playfieldCardIds;
+    for (size_t i = 0; i < playfieldCards.size(); i++)
     {
-        CardModel* card = new CardModel(
-            generateCardId(),
+        const CardConfigData& cardData = playfieldCards[i];
+        CardModel* card = gameModel->createCard(
             static_cast<CardFaceType>(cardData.cardFace),
             static_cast<CardSuitType>(cardData.cardSuit)
         );
         card->setPosition(cardData.position);
+        card->setZOrder(drawRank[i]);
+        card->setFaceUp(cardData.isFaceUp);
         gameModel->addPlayfieldCard(card);
+        playfieldCardIds.push_back(card->getId());
     }
 
-    // 生成备用牌堆卡牌
-    const auto& stackCards = levelConfig->getStackCards();
-    for (const auto& cardData : stackCards)
+    // 遮挡关系从配置中的卡牌下标转换为卡牌ID，主牌区的卡牌ID即下标，按顺序连续存放
+    std::vector<int> blockerOffsets(playfieldCards.size() + 1, 0);
+    std::vector<int> blockerIds;
+    for (size_t i = 0; i < playfieldCards.size(); i++)
     {
-        CardModel* card = new CardModel(
-            generateCardId(),
+        for (int blockerIndex : playfieldCards[i].blockedBy)
+        {
+            if (blockerIndex >= 0 && blockerIndex < static_cast<int>(playfieldCardIds.size()))
+            {
+                blockerIds.push_back(playfieldCardIds[blockerIndex]);
+            }
+        }
+        blockerOffsets[i + 1] = static_cast<int>(blockerIds.size());
+    }
+    gameModel->setCardBlockers(std::move(blockerOffsets), std::move(blockerIds));
+    gameModel->updateBlockedCards();
+
+    // 生成备用牌堆卡牌，初始底牌为备用牌堆的第一张，直接作为底牌不进入牌堆
+    for (size_t i = 0; i < stackCards.size(); i++)
+    {
+        const CardConfigData& cardData = stackCards[i];
+        CardModel* card = gameModel->createCard(
             static_cast<CardFaceType>(cardData.cardFace),
             static_cast<CardSuitType>(cardData.cardSuit)
         );
         card->setPosition(cardData.position);
-        gameModel->addStackCard(card);
-    }
-
-    // 初始底牌为备用牌堆的第一张
-    if (!gameModel->getStackCards().empty())
-    {
-        CardModel* firstStackCard = gameModel->getStackCards().front();
-        gameModel->removeStackCard(firstStackCard);
-        gameModel->setTrayCard(firstStackCard);
+        if (i == 0)
+        {
+            gameModel->setTrayCard(card);
+        }
+        else
+        {
+            gameModel->addStackCard(card);
+        }
     }
 
     return gameModel;
 }
 
-int GameModelGenerator::generateCardId()
+GameModel* GameModelGenerator::generateFromCompiledLevel(const CompiledLevel* compiledLevel)
 {
-    return s_nextCardId++;
+    GAME_TRACE_SCOPE("generateGameModel");
+    if (!compiledLevel || !compiledLevel->isValid()) return nullptr;
+
+    const int playfieldCount = compiledLevel->getPlayfieldCount();
+    const int stackCount = compiledLevel->getStackCount();
+
+    // 关卡文件来自磁盘，点数花色超出范围时拒绝生成
+    auto isCardValid = [](const CompiledCardData& cardData) {
+        return cardData.cardFace < CFT_NUM_CARD_FACE_TYPES && cardData.cardSuit < CST_NUM_CARD_SUIT_TYPES;
+    };
+    for (int i = 0; i < playfieldCount; i++)
+    {
+        if (!isCardValid(compiledLevel->getPlayfieldCards()[i])) return nullptr;
+    }
+    for (int i = 0; i < stackCount; i++)
+    {
+        if (!isCardValid(compiledLevel->getStackCards()[i])) return nullptr;
+    }
+    if (playfieldCount + stackCount > GameModel::kMaxCardCount) return nullptr;
+
+    GameModel* gameModel = new GameModel();
+    gameModel->reserveCards(playfieldCount + stackCount);
+
+    // 生成主牌区卡牌，主牌区的卡牌ID即数组下标
+    const CompiledCardData* playfieldCards = compiledLevel->getPlayfieldCards();
+    for (int i = 0; i < playfieldCount; i++)
+    {
+        const CompiledCardData& cardData = playfieldCards[i];
+        CardModel* card = gameModel->createCard(
+            static_cast<CardFaceType>(cardData.cardFace),
+            static_cast<CardSuitType>(cardData.cardSuit)
+        );
+        card->setPosition(Vec2f(cardData.positionX, cardData.positionY));
+        card->setZOrder(cardData.drawRank);
+        card->setFaceUp(cardData.isFaceUp != 0);
+        gameModel->addPlayfieldCard(card);
+    }
+
+    // 遮挡者下标即卡牌ID，从映射的文件直接转为连续的数组，不按卡牌分配
+    std::vector<int> blockerOffsets(playfieldCount + 1, 0);
+    std::vector<int> blockerIds;
+    blockerIds.reserve(compiledLevel->getBlockerCount());
+    for (int i = 0; i < playfieldCount; i++)
+    {
+        const CompiledCardData& cardData = playfieldCards[i];
+        const uint16_t* blockers = compiledLevel->getBlockers(cardData);
+        blockerIds.insert(blockerIds.end(), blockers, blockers + cardData.blockerCount);
+        blockerOffsets[i + 1] = static_cast<int>(blockerIds.size());
+    }
+    gameModel->setCardBlockers(std::move(blockerOffsets), std::move(blockerIds));
+    gameModel->updateBlockedCards();
+
+    // 生成备用牌堆卡牌，第一张直接作为底牌
+    const CompiledCardData* stackCards = compiledLevel->getStackCards();
+    for (int i = 0; i < stackCount; i++)
+    {
+        const CompiledCardData& cardData = stackCards[i];
+        CardModel* card = gameModel->createCard(
+            static_cast<CardFaceType>(cardData.cardFace),
+            static_cast<CardSuitType>(cardData.cardSuit)
+        );
+        card->setPosition(Vec2f(cardData.positionX, cardData.positionY));
+        if (i == 0)
+        {
+            gameModel->setTrayCard(card);
+        }
+        else
+        {
+            gameModel->addStackCard(card);
+        }
+    }
+
+    return gameModel;
 }
@@ -2,6 +2,7 @@
 #define __GAME_MODEL_GENERATOR_H__
 
 class LevelConfig;
+class CompiledLevel;
 class GameModel;
 
 /**
@@ -14,20 +15,21 @@ class GameModelGenerator
 public:
     /**
      * @brief 从关卡配置生成游戏数据模型
+     * 卡牌ID在每局内从0开始：主牌区按配置顺序在前，备用牌堆在后，同一配置每次生成的ID相同
      * @param levelConfig 关卡配置对象
      * @return 生成的游戏数据模型，失败返回nullptr
      * @note 调用方负责释放返回的GameModel对象
      */
     static GameModel* generateFromLevelConfig(const LevelConfig* levelConfig);
 
-private:
     /**
-     * @brief 生成唯一的卡牌ID
-     * @return 新的卡牌ID
+     * @brief 从编译后的关卡生成游戏数据模型
+     * 遮挡关系和绘制层级直接取自关卡文件，生成的模型（包括卡牌ID）与从同一关卡的JSON生成的相同
+     * @param compiledLevel 已加载的编译关卡
+     * @return 生成的游戏数据模型，失败返回nullptr
+     * @note 调用方负责释放返回的GameModel对象
      */
-    static int generateCardId();
-
-    static int s_nextCardId;  // 下一个可用的卡牌ID
+    static GameModel* generateFromCompiledLevel(const CompiledLevel* compiledLevel);
 };
 
 #endif // __GAME_MODEL_GENERATOR_H__
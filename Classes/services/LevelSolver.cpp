@@ -0,0 +1,480 @@
+#include "LevelSolver.h"
+#include "GameModelGenerator.h"
+#include "../configs/models/LevelConfig.h"
+#include "../models/GameModel.h"
+#include "../models/CardModel.h"
+#include "../models/PackedGameState.h"
+#include "../utils/CardMatchUtils.h"
+#include "../utils/TranspositionTable.h"
+#include "../utils/VisitedStateSet.h"
+#include "../utils/WorkStealingPool.h"
+#include "../utils/ZobristHash.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace
+{
+    const int kSolverVisitedLog2InitialCapacity = 16;      // 单线程已访问集合的初始槽位数量 2^16，按需扩容
+    const int kParallelSolverTableMinLog2Capacity = 20;    // 多线程共享置换表槽位数量下限 2^20（8MB）
+    const int kParallelSolverTableMaxLog2Capacity = 25;    // 多线程共享置换表槽位数量上限 2^25（256MB）
+
+    /**
+     * @brief 按主牌区卡牌数量确定多线程置换表的大小
+     * 置换表满后被覆盖的局面会重复展开，表太小时搜索量成倍增长；
+     * 需要展开的局面数大致随卡牌数指数增长，每多6张牌槽位数量翻倍，66张牌时为2^24
+     * @param playfieldCount 主牌区卡牌数量
+     * @return 槽位数量的以2为底的对数
+     */
+    int getParallelTableLog2Capacity(int playfieldCount)
+    {
+        const int log2Capacity = 13 + playfieldCount / 6;
+        if (log2Capacity < kParallelSolverTableMinLog2Capacity) return kParallelSolverTableMinLog2Capacity;
+        if (log2Capacity > kParallelSolverTableMaxLog2Capacity) return kParallelSolverTableMaxLog2Capacity;
+        return log2Capacity;
+    }
+
+    struct ParallelSearch;
+
+    /**
+     * @brief 一个走法及其到达的局面
+     */
+    struct SearchChild
+    {
+        PackedGameState state;
+        uint64_t hash;
+        SolverMove move;
+        int slot;           // 主牌区槽位，抽牌时为-1
+    };
+
+    /**
+     * @brief 一次求解过程（或并行求解中一个任务）的上下文
+     * 深度优先搜索，已访问过的局面记入集合，不再展开
+     * 单线程求解使用精确的VisitedStateSet，并行求解使用所有线程共享的TranspositionTable
+     * 并行求解时，有空闲线程的分支点把其余子树拆分为新任务
+     */
+    template <typename VisitedSet>
+    class SearchContext
+    {
+    public:
+        SearchContext(const PackedGameLayout& layout, VisitedSet& visited, ParallelSearch* parallel)
+            : _layout(layout)
+            , _visited(visited)
+            , _parallel(parallel)
+            , _explored(0)
+            , _depth(0)
+        {
+            for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; face++) _remainingByFace[face] = 0;
+        }
+
+        /**
+         * @brief 设置搜索起点局面之前的走法
+         * @param path 从开局到起点局面的走法
+         */
+        void setPathPrefix(const std::vector<SolverMove>& path) { _path = path; }
+
+        /**
+         * @brief 统计局面中主牌区每种点数的剩余数量并填充可点击点数数组，搜索前调用一次
+         */
+        void countRemaining(const PackedGameState& state)
+        {
+            state.fillExposedFaces(_layout, _exposedFaces);
+            for (int slot = 0; slot < _layout.getPlayfieldCount(); slot++)
+            {
+                if (state.hasPlayfieldCard(slot)) _remainingByFace[_layout.getPlayfieldFace(slot)]++;
+            }
+        }
+
+        bool search(const PackedGameState& state, uint64_t hash, int remaining);
+
+        const std::vector<SolverMove>& getPath() const { return _path; }
+        long long getExplored() const { return _explored; }
+
+    private:
+        /**
+         * @brief 生成局面的所有候选走法，主牌区消除在前，抽牌在后
+         * @param children 输出参数，保存走法列表
+         */
+        void generateChildren(const PackedGameState& state, uint64_t hash, std::vector<SearchChild>& children) const
+        {
+            children.clear();
+            uint64_t legalMask[2] = {0, 0};
+            CardMatchUtils::getLegalMoveMask(state.trayFace, _exposedFaces, _layout.getPlayfieldCount(), legalMask);
+
+            unsigned triedFaces = 0;
+            for (int word = 0; word < 2; word++)
+            {
+                uint64_t bits = legalMask[word];
+                while (bits)
+                {
+                    const int slot = word * 64 + lowestBitIndex(bits);
+                    bits &= bits - 1;
+
+                    // 没有压着其他牌时，点数相同的卡牌可互换，每种点数只需尝试一张
+                    const int face = _exposedFaces[slot];
+                    if (!state.isPlayfieldCardCovering(_layout, slot))
+                    {
+                        if (triedFaces & (1u << face)) continue;
+                        triedFaces |= 1u << face;
+                    }
+
+                    children.push_back(SearchChild());
+                    SearchChild& child = children.back();
+                    child.state = state;
+                    child.state.movePlayfieldCardToTray(slot, face);
+                    child.hash = hash ^ _layout.getPlayfieldKey(slot)
+                               ^ ZobristHash::trayKey(state.trayFace) ^ ZobristHash::trayKey(face);
+                    child.move = SolverMove(SMT_PLAYFIELD_TO_TRAY, _layout.getPlayfieldCardId(slot), face);
+                    child.slot = slot;
+                }
+            }
+
+            if (state.stackCursor < _layout.getStackCount())
+            {
+                children.push_back(SearchChild());
+                SearchChild& child = children.back();
+                child.state = state;
+                child.state.moveStackCardToTray(_layout);
+                child.hash = hash ^ _layout.getStackKey(state.stackCursor)
+                           ^ ZobristHash::trayKey(state.trayFace) ^ ZobristHash::trayKey(child.state.trayFace);
+                child.move = SolverMove(SMT_STACK_TO_TRAY, _layout.getStackCardId(state.stackCursor), child.state.trayFace);
+                child.slot = -1;
+            }
+        }
+
+        /**
+         * @brief 必要条件剪枝
+         * 每消除一张点数为f的牌，当时的底牌必须是f-1或f+1：要么是剩余的主牌区卡牌，
+         * 要么是当前底牌或剩余的备用牌，且每张牌最多作为一次前驱
+         * 这是点数环上的二分图匹配，供给点和需求点交替排成长度26的环，可以贪心判定
+         * @return 剩余卡牌仍可能全部消除返回true
+         */
+        bool canStillClear(const PackedGameState& state) const
+        {
+            const int kFaces = CFT_NUM_CARD_FACE_TYPES;
+            int supply[CFT_NUM_CARD_FACE_TYPES];
+            for (int face = 0; face < kFaces; face++) supply[face] = _remainingByFace[face];
+            supply[state.trayFace]++;
+            for (int index = state.stackCursor; index < _layout.getStackCount(); index++)
+            {
+                supply[_layout.getStackFace(index)]++;
+            }
+
+            // 环上偶数位置p为点数p%13的供给，奇数位置为点数p%13的需求
+            // 枚举从位置0流向位置25（环的闭合边）的流量wrap，wrap越大中间越难满足
+            int low = 0;
+            int high = supply[0];
+            int best = -1;
+            while (low <= high)
+            {
+                const int wrap = (low + high) / 2;
+                int shortage = 0;
+                if (routeAlongCycle(supply, wrap, shortage))
+                {
+                    best = wrap;
+                    low = wrap + 1;
+                }
+                else
+                {
+                    high = wrap - 1;
+                }
+            }
+            if (best < 0) return false;
+
+            int shortage = 0;
+            routeAlongCycle(supply, best, shortage);
+            return shortage <= best;
+        }
+
+        /**
+         * @brief 沿环（断开闭合边后的路径）贪心分配前驱
+         * @param supply 每种点数可作为前驱的牌数
+         * @param wrap 位置0的供给预留给位置25的数量
+         * @param outShortage 输出参数，位置25仍缺少的前驱数量
+         * @return 中间需求全部满足返回true
+         */
+        bool routeAlongCycle(const int* supply, int wrap, int& outShortage) const
+        {
+            const int kFaces = CFT_NUM_CARD_FACE_TYPES;
+            int carry = supply[0] - wrap;
+            for (int p = 1; p < kFaces * 2; p += 2)
+            {
+                const int demand = _remainingByFace[p % kFaces];
+                const int fromPrevious = carry < demand ? carry : demand;
+                const int rest = demand - fromPrevious;
+                if (p == kFaces * 2 - 1)
+                {
+                    outShortage = rest;
+                    return true;
+                }
+
+                const int nextSupply = supply[(p + 1) % kFaces];
+                if (nextSupply < rest) return false;
+                carry = nextSupply - rest;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 获取最低位1的下标（bits不为0）
+         */
+        static int lowestBitIndex(uint64_t bits)
+        {
+            int index = 0;
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+
+        /**
+         * @brief 进入子局面前后更新剩余点数统计和可点击点数数组
+         * 只有被移除的牌直接压住的牌可能改变可点击状态
+         */
+        void applyChild(const SearchChild& child)
+        {
+            _path.push_back(child.move);
+            if (child.slot >= 0)
+            {
+                _remainingByFace[child.move.cardFace]--;
+                _exposedFaces[child.slot] = CardMatchUtils::kNoFace;
+
+                const uint64_t* covers = _layout.getPlayfieldCoverMask(child.slot);
+                for (int word = 0; word < 2; word++)
+                {
+                    uint64_t bits = covers[word];
+                    while (bits)
+                    {
+                        const int covered = word * 64 + lowestBitIndex(bits);
+                        bits &= bits - 1;
+                        if (child.state.isPlayfieldCardExposed(_layout, covered))
+                        {
+                            _exposedFaces[covered] = static_cast<uint8_t>(_layout.getPlayfieldFace(covered));
+                        }
+                    }
+                }
+            }
+        }
+
+        void revertChild(const SearchChild& child)
+        {
+            if (child.slot >= 0)
+            {
+                _remainingByFace[child.move.cardFace]++;
+                _exposedFaces[child.slot] = static_cast<uint8_t>(child.move.cardFace);
+
+                const uint64_t* covers = _layout.getPlayfieldCoverMask(child.slot);
+                for (int word = 0; word < 2; word++)
+                {
+                    uint64_t bits = covers[word];
+                    while (bits)
+                    {
+                        const int covered = word * 64 + lowestBitIndex(bits);
+                        bits &= bits - 1;
+                        _exposedFaces[covered] = CardMatchUtils::kNoFace;
+                    }
+                }
+            }
+            _path.pop_back();
+        }
+
+        /**
+         * @brief 获取当前搜索深度的走法缓冲区，避免每个节点分配内存
+         * deque扩容时不会移动已有元素，上层持有的引用保持有效
+         */
+        std::vector<SearchChild>& getChildBuffer()
+        {
+            if (_depth >= _childBuffers.size()) _childBuffers.resize(_depth + 1);
+            return _childBuffers[_depth];
+        }
+
+        const PackedGameLayout& _layout;                    // 关卡布局
+        VisitedSet& _visited;                               // 已展开的局面（并行时为共享置换表）
+        ParallelSearch* _parallel;                          // 并行求解的共享状态，单线程时为nullptr
+        int _remainingByFace[CFT_NUM_CARD_FACE_TYPES];      // 主牌区每种点数剩余数量
+        uint8_t _exposedFaces[kPackedMaxPlayfieldCards];    // 每个槽位的可点击点数，已移除为kNoFace
+        std::vector<SolverMove> _path;                      // 当前搜索路径
+        long long _explored;                                // 搜索过的局面数量
+        std::deque<std::vector<SearchChild>> _childBuffers; // 每层搜索深度的走法缓冲区
+        size_t _depth;                                      // 当前搜索深度
+    };
+
+    /**
+     * @brief 并行求解的共享状态
+     */
+    struct ParallelSearch
+    {
+        ParallelSearch(const PackedGameLayout& searchLayout, int threadCount)
+            : layout(searchLayout)
+            , visited(getParallelTableLog2Capacity(searchLayout.getPlayfieldCount()))
+            , solved(false)
+            , explored(0)
+            , pool(threadCount)
+        {
+        }
+
+        /**
+         * @brief 把一棵子树作为新任务提交到线程池
+         */
+        void spawn(const PackedGameState& state, uint64_t hash, int remaining, const std::vector<SolverMove>& path)
+        {
+            pool.submit([this, state, hash, remaining, path]() {
+                run(state, hash, remaining, path);
+            });
+        }
+
+        /**
+         * @brief 搜索一棵子树，找到通关走法时记录结果并通知其他任务停止
+         */
+        void run(const PackedGameState& state, uint64_t hash, int remaining, const std::vector<SolverMove>& path)
+        {
+            if (solved.load(std::memory_order_relaxed)) return;
+
+            SearchContext<TranspositionTable> context(layout, visited, this);
+            context.setPathPrefix(path);
+            context.countRemaining(state);
+
+            bool found = context.search(state, hash, remaining);
+            explored.fetch_add(context.getExplored(), std::memory_order_relaxed);
+
+            bool expected = false;
+            if (found && solved.compare_exchange_strong(expected, true))
+            {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                moves = context.getPath();
+            }
+        }
+
+        const PackedGameLayout& layout;         // 关卡布局
+        TranspositionTable visited;             // 所有任务共享的置换表
+        std::atomic<bool> solved;               // 是否已有任务找到通关走法，同时作为取消标志
+        std::atomic<long long> explored;        // 所有任务搜索过的局面数量
+        std::mutex resultMutex;                 // 保护moves
+        std::vector<SolverMove> moves;          // 通关走法
+        WorkStealingPool pool;                  // 线程池，最后构造、最先析构
+    };
+
+    template <typename VisitedSet>
+    bool SearchContext<VisitedSet>::search(const PackedGameState& state, uint64_t hash, int remaining)
+    {
+        ++_explored;
+        if (remaining == 0) return true;
+
+        // 其他任务已找到通关走法，放弃当前子树
+        if (_parallel && _parallel->solved.load(std::memory_order_relaxed)) return false;
+
+        // 同一局面可由不同走法顺序到达，只展开一次
+        if (!_visited.insert(hash)) return false;
+        if (!canStillClear(state)) return false;
+
+        std::vector<SearchChild>& children = getChildBuffer();
+        generateChildren(state, hash, children);
+        const int childCount = static_cast<int>(children.size());
+
+        ++_depth;
+        bool found = false;
+        for (int i = 0; i < childCount && !found; i++)
+        {
+            const SearchChild& child = children[i];
+            const int childRemaining = child.slot >= 0 ? remaining - 1 : remaining;
+
+            // 根节点和深层分支点：有空闲线程时把后面的兄弟子树交给其他线程
+            if (_parallel && i + 1 < childCount && _parallel->pool.hasIdleWorker())
+            {
+                for (int j = i + 1; j < childCount; j++)
+                {
+                    const SearchChild& sibling = children[j];
+                    _path.push_back(sibling.move);
+                    _parallel->spawn(sibling.state, sibling.hash,
+                                     sibling.slot >= 0 ? remaining - 1 : remaining, _path);
+                    _path.pop_back();
+                }
+
+                applyChild(child);
+                found = search(child.state, child.hash, childRemaining);
+                if (!found) revertChild(child);
+                break;
+            }
+
+            applyChild(child);
+            found = search(child.state, child.hash, childRemaining);
+            if (!found) revertChild(child);
+        }
+        --_depth;
+
+        return found;
+    }
+}
+
+bool LevelSolver::solve(const LevelConfig* levelConfig, SolverResult& outResult)
+{
+    outResult = SolverResult();
+    if (!levelConfig) return false;
+
+    GameModel* gameModel = GameModelGenerator::generateFromLevelConfig(levelConfig);
+    if (!gameModel) return false;
+
+    bool solved = solve(gameModel, outResult);
+    delete gameModel;
+    return solved;
+}
+
+bool LevelSolver::solve(const GameModel* gameModel, SolverResult& outResult)
+{
+    outResult = SolverResult();
+
+    PackedGameLayout layout;
+    if (!layout.buildFromGameModel(gameModel)) return false;
+
+    VisitedStateSet visited(kSolverVisitedLog2InitialCapacity);
+    SearchContext<VisitedStateSet> context(layout, visited, nullptr);
+    PackedGameState state = PackedGameState::createInitial(layout);
+    context.countRemaining(state);
+
+    outResult.solved = context.search(state, state.computeHash(layout), layout.getPlayfieldCount());
+    outResult.exploredStates = context.getExplored();
+    if (outResult.solved)
+    {
+        outResult.moves = context.getPath();
+    }
+    return outResult.solved;
+}
+
+bool LevelSolver::solveParallel(const LevelConfig* levelConfig, int threadCount, SolverResult& outResult)
+{
+    outResult = SolverResult();
+    if (!levelConfig) return false;
+
+    GameModel* gameModel = GameModelGenerator::generateFromLevelConfig(levelConfig);
+    if (!gameModel) return false;
+
+    bool solved = solveParallel(gameModel, threadCount, outResult);
+    delete gameModel;
+    return solved;
+}
+
+bool LevelSolver::solveParallel(const GameModel* gameModel, int threadCount, SolverResult& outResult)
+{
+    outResult = SolverResult();
+
+    PackedGameLayout layout;
+    if (!layout.buildFromGameModel(gameModel)) return false;
+
+    ParallelSearch parallel(layout, threadCount);
+    PackedGameState state = PackedGameState::createInitial(layout);
+
+    // 根任务开始时所有其他线程都空闲，根节点的分支会立即被拆分出去
+    parallel.spawn(state, state.computeHash(layout), layout.getPlayfieldCount(), std::vector<SolverMove>());
+    parallel.pool.waitIdle();
+
+    outResult.solved = parallel.solved.load();
+    outResult.exploredStates = parallel.explored.load();
+    if (outResult.solved)
+    {
+        std::lock_guard<std::mutex> lock(parallel.resultMutex);
+        outResult.moves = parallel.moves;
+    }
+    return outResult.solved;
+}
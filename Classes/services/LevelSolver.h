@@ -0,0 +1,90 @@
+#ifndef __LEVEL_SOLVER_H__
+#define __LEVEL_SOLVER_H__
+
+#include <vector>
+
+class LevelConfig;
+class GameModel;
+
+/**
+ * @brief 求解步骤类型
+ */
+enum SolverMoveType
+{
+    SMT_PLAYFIELD_TO_TRAY,  // 主牌区卡牌移动到底牌
+    SMT_STACK_TO_TRAY,      // 备用牌堆顶牌移动到底牌
+};
+
+/**
+ * @brief 求解得到的一步操作
+ */
+struct SolverMove
+{
+    SolverMoveType type;    // 操作类型
+    int cardId;             // 移动的卡牌ID
+    int cardFace;           // 移动的卡牌点数 (0-A, 1-2, ..., 12-K)
+
+    SolverMove() : type(SMT_PLAYFIELD_TO_TRAY), cardId(0), cardFace(0) {}
+    SolverMove(SolverMoveType t, int id, int face) : type(t), cardId(id), cardFace(face) {}
+};
+
+/**
+ * @brief 求解结果
+ */
+struct SolverResult
+{
+    bool solved;                    // 是否可通关
+    std::vector<SolverMove> moves;  // 通关步骤（仅solved为true时有效）
+    long long exploredStates;       // 搜索过的局面数量
+
+    SolverResult() : solved(false), exploredStates(0) {}
+};
+
+/**
+ * @brief 关卡求解服务
+ * 对关卡的完整走法树做穷举搜索，判断关卡能否通关并给出通关步骤
+ * 不依赖视图层，可在无界面环境（命令行、CI）中运行
+ * 这是一个无状态的服务类，不持有数据，通过参数操作或返回数据
+ */
+class LevelSolver
+{
+public:
+    /**
+     * @brief 求解关卡配置
+     * 使用GameModelGenerator生成与游戏中一致的初始局面后进行搜索
+     * @param levelConfig 关卡配置对象
+     * @param outResult 输出参数，保存求解结果
+     * @return 可通关返回true
+     */
+    static bool solve(const LevelConfig* levelConfig, SolverResult& outResult);
+
+    /**
+     * @brief 从当前游戏局面开始求解
+     * @param gameModel 游戏数据模型（只读，不会被修改）
+     * @param outResult 输出参数，保存求解结果
+     * @return 可通关返回true
+     */
+    static bool solve(const GameModel* gameModel, SolverResult& outResult);
+
+    /**
+     * @brief 多线程求解关卡配置
+     * 在工作窃取线程池上拆分走法树，所有线程共享置换表，任一线程找到通关走法后其余线程立即停止
+     * 无解关卡需要证明每个分支都走不通，多线程收益最明显
+     * @param levelConfig 关卡配置对象
+     * @param threadCount 线程数量，小于1时使用硬件线程数
+     * @param outResult 输出参数，保存求解结果
+     * @return 可通关返回true
+     */
+    static bool solveParallel(const LevelConfig* levelConfig, int threadCount, SolverResult& outResult);
+
+    /**
+     * @brief 多线程从当前游戏局面开始求解
+     * @param gameModel 游戏数据模型（只读，不会被修改）
+     * @param threadCount 线程数量，小于1时使用硬件线程数
+     * @param outResult 输出参数，保存求解结果
+     * @return 可通关返回true
+     */
+    static bool solveParallel(const GameModel* gameModel, int threadCount, SolverResult& outResult);
+};
+
+#endif // __LEVEL_SOLVER_H__
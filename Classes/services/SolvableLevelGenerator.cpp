@@ -0,0 +1,235 @@
+#include "SolvableLevelGenerator.h"
+#include "DifficultyEstimator.h"
+#include "../configs/models/CardResConfig.h"
+#include "../models/CardModel.h"
+#include "../utils/CardOcclusionUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+    const int kFaces = CFT_NUM_CARD_FACE_TYPES;
+    const int kSuits = CST_NUM_CARD_SUIT_TYPES;
+
+    /**
+     * @brief 按遮挡关系随机生成一条合法的消除顺序
+     * 一张牌的所有遮挡者都被消除后才能加入顺序，每次从当前可消除的牌中随机选一张
+     */
+    std::vector<int> buildRemovalOrder(const std::vector<CardConfigData>& cards, std::mt19937_64& random)
+    {
+        const int count = static_cast<int>(cards.size());
+        std::vector<int> blockerCounts(count, 0);
+        std::vector<std::vector<int>> covers(count);
+        for (int i = 0; i < count; i++)
+        {
+            blockerCounts[i] = static_cast<int>(cards[i].blockedBy.size());
+            for (int blocker : cards[i].blockedBy)
+            {
+                covers[blocker].push_back(i);
+            }
+        }
+
+        std::vector<int> available;
+        for (int i = 0; i < count; i++)
+        {
+            if (blockerCounts[i] == 0) available.push_back(i);
+        }
+
+        std::vector<int> order;
+        order.reserve(count);
+        while (!available.empty())
+        {
+            const size_t pick = random() % available.size();
+            const int index = available[pick];
+            available[pick] = available.back();
+            available.pop_back();
+            order.push_back(index);
+
+            for (int covered : covers[index])
+            {
+                if (--blockerCounts[covered] == 0) available.push_back(covered);
+            }
+        }
+        return order;
+    }
+
+    /**
+     * @brief 沿消除顺序分配点数，生成一个关卡
+     * 每张牌的点数取当时底牌的相邻点数；以一定概率先抽一张备用牌换底牌，打断连续消除
+     */
+    LevelConfig* buildLevel(const std::vector<CardConfigData>& layout, const LevelGenerateParams& params,
+                            std::mt19937_64& random)
+    {
+        std::vector<CardConfigData> playfieldCards = layout;
+        const std::vector<int> order = buildRemovalOrder(playfieldCards, random);
+
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        const float drawProbability = 0.05f + 0.45f * params.difficulty;
+
+        const int initialTrayFace = static_cast<int>(random() % kFaces);
+        std::vector<int> drawnFaces;
+        int trayFace = initialTrayFace;
+        for (int index : order)
+        {
+            if (chance(random) < drawProbability)
+            {
+                trayFace = static_cast<int>(random() % kFaces);
+                drawnFaces.push_back(trayFace);
+            }
+
+            const int step = (random() & 1) ? 1 : kFaces - 1;
+            trayFace = (trayFace + step) % kFaces;
+            playfieldCards[index].cardFace = trayFace;
+            playfieldCards[index].cardSuit = static_cast<int>(random() % kSuits);
+        }
+
+        // 备用牌堆第一张为初始底牌，其余从列表末尾开始抽取：
+        // 先放通关走法用不到的干扰牌（最后才会抽到），再倒序放入走法中需要抽的牌
+        std::vector<CardConfigData> stackCards;
+        CardConfigData trayData;
+        trayData.cardFace = initialTrayFace;
+        trayData.cardSuit = static_cast<int>(random() % kSuits);
+        stackCards.push_back(trayData);
+
+        const int decoyCount = static_cast<int>(std::lround(params.difficulty * playfieldCards.size() / 4.0f));
+        for (int i = 0; i < decoyCount; i++)
+        {
+            CardConfigData decoy;
+            decoy.cardFace = static_cast<int>(random() % kFaces);
+            decoy.cardSuit = static_cast<int>(random() % kSuits);
+            stackCards.push_back(decoy);
+        }
+        for (auto it = drawnFaces.rbegin(); it != drawnFaces.rend(); ++it)
+        {
+            CardConfigData drawn;
+            drawn.cardFace = *it;
+            drawn.cardSuit = static_cast<int>(random() % kSuits);
+            stackCards.push_back(drawn);
+        }
+
+        LevelConfig* levelConfig = new LevelConfig();
+        levelConfig->setPlayfieldCards(playfieldCards);
+        levelConfig->setStackCards(stackCards);
+        levelConfig->setCoinReward(params.coinReward);
+        return levelConfig;
+    }
+}
+
+LevelConfig* SolvableLevelGenerator::generate(const std::vector<CardConfigData>& layoutTemplate,
+                                              const LevelGenerateParams& params, uint64_t seed)
+{
+    if (layoutTemplate.empty()) return nullptr;
+
+    // 取模板的前cardCount个位置，遮挡关系只在选中的牌之间计算
+    // 备用牌堆最多为主牌区的1.25倍加1张，主牌区不超过上限的三分之一，整个关卡就不会超过kLevelMaxCardCount
+    const size_t maxCardCount = static_cast<size_t>(kLevelMaxCardCount / 3);
+    const size_t cardCount = std::min(params.cardCount > 0 && static_cast<size_t>(params.cardCount) < layoutTemplate.size()
+                                      ? static_cast<size_t>(params.cardCount) : layoutTemplate.size(), maxCardCount);
+    std::vector<CardConfigData> layout(layoutTemplate.begin(), layoutTemplate.begin() + cardCount);
+    CardOcclusionUtils::computeBlockedBy(layout, CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+
+    std::mt19937_64 random(seed);
+    LevelConfig* best = nullptr;
+    float bestError = 0.0f;
+    const int attempts = params.verifyPlayouts > 0 && params.maxAttempts > 1 ? params.maxAttempts : 1;
+    for (int attempt = 0; attempt < attempts; attempt++)
+    {
+        LevelConfig* candidate = buildLevel(layout, params, random);
+        if (params.verifyPlayouts <= 0) return candidate;
+
+        DifficultyReport report;
+        DifficultyEstimator::estimate(candidate, PPT_PREFER_PLAYFIELD, params.verifyPlayouts, 1,
+                                      random(), report);
+        const float error = std::fabs(static_cast<float>(1.0 - report.getWinRate()) - params.difficulty);
+
+        if (!best || error < bestError)
+        {
+            delete best;
+            best = candidate;
+            bestError = error;
+        }
+        else
+        {
+            delete candidate;
+        }
+
+        if (bestError <= params.tolerance) break;
+    }
+    return best;
+}
+
+int SolvableLevelGenerator::generateBatch(const std::vector<CardConfigData>& layoutTemplate, const LevelGenerateParams& params,
+                                          uint64_t seed, int count, std::vector<LevelConfig*>& outLevels)
+{
+    std::unordered_set<uint64_t> seenHashes;
+    int generated = 0;
+
+    // 每个关卡用不同的子种子，重复的关卡丢弃，最多尝试count的4倍次
+    for (long long attempt = 0; generated < count && attempt < 4LL * count; attempt++)
+    {
+        const uint64_t levelSeed = seed + static_cast<uint64_t>(attempt) * 0x9E3779B97F4A7C15ULL;
+        LevelConfig* levelConfig = generate(layoutTemplate, params, levelSeed);
+        if (!levelConfig) break;
+
+        if (!seenHashes.insert(computeContentHash(levelConfig)).second)
+        {
+            delete levelConfig;
+            continue;
+        }
+
+        outLevels.push_back(levelConfig);
+        generated++;
+    }
+    return generated;
+}
+
+std::vector<CardConfigData> SolvableLevelGenerator::createPyramidLayout(int rows, float topX, float topY)
+{
+    std::vector<CardConfigData> layout;
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column <= row; column++)
+        {
+            CardConfigData data;
+            data.position.x = topX + (column - row * 0.5f) * CardResConfig::kCardWidth;
+            data.position.y = topY - row * CardResConfig::kCardHeight * 0.5f;
+            data.zOrder = row;
+            layout.push_back(data);
+        }
+    }
+    return layout;
+}
+
+uint64_t SolvableLevelGenerator::computeContentHash(const LevelConfig* levelConfig)
+{
+    if (!levelConfig) return 0;
+
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; i++)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    };
+    auto mixCards = [&mix](const std::vector<CardConfigData>& cards) {
+        mix(cards.size());
+        for (const auto& data : cards)
+        {
+            uint32_t x = 0;
+            uint32_t y = 0;
+            std::memcpy(&x, &data.position.x, sizeof(x));
+            std::memcpy(&y, &data.position.y, sizeof(y));
+            mix((static_cast<uint64_t>(data.cardFace) << 8) | static_cast<uint64_t>(data.cardSuit & 0xFF));
+            mix((static_cast<uint64_t>(x) << 32) | y);
+            mix(static_cast<uint64_t>(static_cast<int64_t>(data.zOrder)));
+        }
+    };
+    mixCards(levelConfig->getPlayfieldCards());
+    mixCards(levelConfig->getStackCards());
+    return hash;
+}
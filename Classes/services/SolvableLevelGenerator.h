@@ -0,0 +1,82 @@
+#ifndef __SOLVABLE_LEVEL_GENERATOR_H__
+#define __SOLVABLE_LEVEL_GENERATOR_H__
+
+#include "../configs/models/LevelConfig.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 关卡生成参数
+ */
+struct LevelGenerateParams
+{
+    int cardCount;          // 主牌区卡牌数量，超过布局模板的位置数量时取模板全部位置，最多kLevelMaxCardCount的三分之一
+    float difficulty;       // 目标难度[0, 1]，以“优先消除主牌区”策略模拟的失败率衡量
+    float tolerance;        // 允许的难度误差
+    int verifyPlayouts;     // 校验难度的模拟局数，为0时不校验，直接按参数生成
+    int maxAttempts;        // 难度不达标时的最多尝试次数，用尽后返回最接近的一个
+    int coinReward;         // 关卡奖励金币
+
+    LevelGenerateParams()
+        : cardCount(20)
+        , difficulty(0.5f)
+        , tolerance(0.1f)
+        , verifyPlayouts(256)
+        , maxAttempts(16)
+        , coinReward(100)
+    {
+    }
+};
+
+/**
+ * @brief 必定可通关的关卡生成服务
+ * 与GameModelGenerator同级：GameModelGenerator把配置变成运行时数据，本服务生成配置本身
+ * 先按遮挡关系随机选出一条合法的消除顺序（通关走法），再沿着这条走法为每张牌分配点数，
+ * 使每一步都与当时的底牌相邻，需要换底牌的地方插入一张备用牌，因此生成的关卡按构造必定可通关
+ * 这是一个无状态的服务类，不持有数据，通过参数操作或返回数据
+ */
+class SolvableLevelGenerator
+{
+public:
+    /**
+     * @brief 生成一个关卡
+     * @param layoutTemplate 布局模板，只使用位置和层级，点数花色会被替换
+     * @param params 生成参数
+     * @param seed 随机种子，相同输入生成相同关卡
+     * @return 生成的关卡配置，模板为空时返回nullptr
+     * @note 调用方负责释放返回的LevelConfig对象
+     */
+    static LevelConfig* generate(const std::vector<CardConfigData>& layoutTemplate,
+                                 const LevelGenerateParams& params, uint64_t seed);
+
+    /**
+     * @brief 批量生成互不相同的关卡
+     * @param layoutTemplate 布局模板
+     * @param params 生成参数
+     * @param seed 随机种子
+     * @param count 需要的关卡数量
+     * @param outLevels 输出参数，追加生成的关卡，调用方负责释放
+     * @return 实际生成的数量（重复过多时可能少于count）
+     */
+    static int generateBatch(const std::vector<CardConfigData>& layoutTemplate, const LevelGenerateParams& params,
+                             uint64_t seed, int count, std::vector<LevelConfig*>& outLevels);
+
+    /**
+     * @brief 创建金字塔布局模板
+     * 第i行（从上往下，从0开始）有i+1张牌，每行下移半张牌高并压住上一行相邻的两张牌
+     * @param rows 行数
+     * @param topX 塔尖卡牌的x坐标
+     * @param topY 塔尖卡牌的y坐标
+     * @return 布局模板
+     */
+    static std::vector<CardConfigData> createPyramidLayout(int rows, float topX, float topY);
+
+    /**
+     * @brief 计算关卡内容的哈希（点数、花色和位置），用于去重
+     * @param levelConfig 关卡配置对象
+     * @return 内容哈希
+     */
+    static uint64_t computeContentHash(const LevelConfig* levelConfig);
+};
+
+#endif // __SOLVABLE_LEVEL_GENERATOR_H__
@@ -1,16 +1,30 @@
 #include "CardMatchUtils.h"
-#include "../models/CardModel.h"
-#include <cmath>
+
+const uint8_t CardMatchUtils::kNoFace;
+
+// 行列依次为 A, 2, ..., K, 空位
+const uint8_t CardMatchUtils::s_faceAdjacency[CFT_NUM_CARD_FACE_TYPES + 1][CFT_NUM_CARD_FACE_TYPES + 1] = {
+    {0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0},
+    {1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0},
+    {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+};
 
 bool CardMatchUtils::canMatch(const CardModel* card1, const CardModel* card2)
 {
     if (!card1 || !card2) return false;
 
-    int face1 = card1->getFaceValue();
-    int face2 = card2->getFaceValue();
-
-    int diff = getFaceDifference(face1, face2);
-    return diff == 1;
+    return canMatchFace(card1->getFace(), card2->getFace());
 }
 
 bool CardMatchUtils::canMatchWithTray(const CardModel* card, const CardModel* trayCard)
@@ -18,15 +32,30 @@ bool CardMatchUtils::canMatchWithTray(const CardModel* card, const CardModel* tr
     return canMatch(card, trayCard);
 }
 
-int CardMatchUtils::getFaceDifference(int face1, int face2)
+bool CardMatchUtils::canMatchFace(CardFaceType face1, CardFaceType face2)
+{
+    if (face1 <= CFT_NONE || face1 >= CFT_NUM_CARD_FACE_TYPES) return false;
+    if (face2 <= CFT_NONE || face2 >= CFT_NUM_CARD_FACE_TYPES) return false;
+
+    return s_faceAdjacency[face1][face2] != 0;
+}
+
+void CardMatchUtils::getLegalMoveMask(int trayFace, const uint8_t* exposedFaces, int count, uint64_t* outMask)
 {
-    // 计算普通差值
-    int normalDiff = std::abs(face1 - face2);
+    if (trayFace < 0 || trayFace > kNoFace) trayFace = kNoFace;
 
-    // 考虑A(1)和K(13)的循环情况
-    // A可以和2或K匹配，K可以和Q或A匹配
-    int circularDiff = 13 - normalDiff;
+    const uint8_t* row = s_faceAdjacency[trayFace];
+    const int wordCount = (count + 63) / 64;
+    for (int word = 0; word < wordCount; word++)
+    {
+        const int begin = word * 64;
+        const int end = count < begin + 64 ? count : begin + 64;
 
-    // 返回较小的差值
-    return std::min(normalDiff, circularDiff);
+        uint64_t mask = 0;
+        for (int i = begin; i < end; i++)
+        {
+            mask |= static_cast<uint64_t>(row[exposedFaces[i]]) << (i - begin);
+        }
+        outMask[word] = mask;
+    }
 }
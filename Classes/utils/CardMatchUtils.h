@@ -1,15 +1,23 @@
 #ifndef __CARD_MATCH_UTILS_H__
 #define __CARD_MATCH_UTILS_H__
 
-class CardModel;
+#include "../models/CardModel.h"
+#include <cstdint>
 
 /**
  * @brief 卡牌匹配工具类
  * 提供卡牌匹配规则的判断逻辑
+ * 规则由预计算的点数邻接表给出，单次判断和批量生成合法走法都只做查表
  */
 class CardMatchUtils
 {
 public:
+    /**
+     * @brief 空位的点数
+     * 在可点击点数数组中表示已移除或被遮挡的卡牌，与任何底牌都不匹配
+     */
+    static const uint8_t kNoFace = CFT_NUM_CARD_FACE_TYPES;
+
     /**
      * @brief 判断两张卡牌是否可以匹配消除
      * 匹配规则：卡牌点数差值为1（无花色限制）
@@ -29,14 +37,31 @@ public:
      */
     static bool canMatchWithTray(const CardModel* card, const CardModel* trayCard);
 
+    /**
+     * @brief 判断两个点数是否可以匹配消除
+     * 与canMatch规则相同，供不持有CardModel的搜索代码使用
+     * @param face1 第一张卡牌的点数
+     * @param face2 第二张卡牌的点数
+     * @return 可以匹配返回true，否则返回false
+     */
+    static bool canMatchFace(CardFaceType face1, CardFaceType face2);
+
+    /**
+     * @brief 一次生成所有合法的主牌区走法
+     * 对每个槽位查表得到0/1并移位合入掩码，循环中没有分支
+     * @param trayFace 当前底牌点数，没有底牌时传kNoFace
+     * @param exposedFaces 每个主牌区槽位的点数，已移除或被遮挡的槽位为kNoFace
+     * @param count 槽位数量
+     * @param outMask 输出参数，至少(count + 63) / 64个字，第i位为1表示槽位i可以移动到底牌
+     */
+    static void getLegalMoveMask(int trayFace, const uint8_t* exposedFaces, int count, uint64_t* outMask);
+
 private:
     /**
-     * @brief 获取两个点数之间的差值（考虑A和K的循环）
-     * @param face1 第一张卡牌的点数值
-     * @param face2 第二张卡牌的点数值
-     * @return 点数差值的绝对值
+     * @brief 点数邻接表
+     * s_faceAdjacency[a][b]为1表示点数a和b可以匹配（含A和K循环），最后一行和一列对应kNoFace
      */
-    static int getFaceDifference(int face1, int face2);
+    static const uint8_t s_faceAdjacency[CFT_NUM_CARD_FACE_TYPES + 1][CFT_NUM_CARD_FACE_TYPES + 1];
 };
 
 #endif // __CARD_MATCH_UTILS_H__
@@ -0,0 +1,100 @@
+#include "CardOcclusionUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief 网格中的一张卡牌
+     */
+    struct GridEntry
+    {
+        int cellX;
+        int cellY;
+        int index;
+
+        bool operator<(const GridEntry& other) const
+        {
+            if (cellX != other.cellX) return cellX < other.cellX;
+            if (cellY != other.cellY) return cellY < other.cellY;
+            return index < other.index;
+        }
+    };
+}
+
+void CardOcclusionUtils::computeBlockedBy(std::vector<CardConfigData>& cards, float cardWidth, float cardHeight)
+{
+    const int count = static_cast<int>(cards.size());
+    for (auto& card : cards)
+    {
+        card.blockedBy.clear();
+    }
+    if (count == 0 || cardWidth <= 0 || cardHeight <= 0) return;
+
+    // 按所在格子排序，同一格子的卡牌连续存放
+    std::vector<GridEntry> grid(count);
+    for (int i = 0; i < count; i++)
+    {
+        grid[i].cellX = static_cast<int>(std::floor(cards[i].position.x / cardWidth));
+        grid[i].cellY = static_cast<int>(std::floor(cards[i].position.y / cardHeight));
+        grid[i].index = i;
+    }
+    std::sort(grid.begin(), grid.end());
+
+    // 遮挡者先收集到复用的缓冲区，排好序后一次写入，每张牌只分配一次
+    std::vector<int> blockers;
+    for (int i = 0; i < count; i++)
+    {
+        const CardConfigData& card = cards[i];
+        const int cellX = static_cast<int>(std::floor(card.position.x / cardWidth));
+        const int cellY = static_cast<int>(std::floor(card.position.y / cardHeight));
+
+        blockers.clear();
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            // 同一列上下相邻的三个格子在排序后连续存放，一次查找即可
+            GridEntry key;
+            key.cellX = cellX + dx;
+            key.cellY = cellY - 1;
+            key.index = -1;
+
+            for (auto it = std::lower_bound(grid.begin(), grid.end(), key);
+                 it != grid.end() && it->cellX == key.cellX && it->cellY <= cellY + 1; ++it)
+            {
+                const int other = it->index;
+                if (other == i) continue;
+
+                const CardConfigData& otherCard = cards[other];
+                if (std::fabs(otherCard.position.x - card.position.x) >= cardWidth) continue;
+                if (std::fabs(otherCard.position.y - card.position.y) >= cardHeight) continue;
+
+                if (isAbove(cards, other, i))
+                {
+                    blockers.push_back(other);
+                }
+            }
+        }
+
+        std::sort(blockers.begin(), blockers.end());
+        cards[i].blockedBy.assign(blockers.begin(), blockers.end());
+    }
+}
+
+bool CardOcclusionUtils::isAbove(const std::vector<CardConfigData>& cards, int a, int b)
+{
+    if (cards[a].zOrder != cards[b].zOrder) return cards[a].zOrder > cards[b].zOrder;
+    return a > b;
+}
+
+std::vector<int> CardOcclusionUtils::computeDrawRanks(const std::vector<CardConfigData>& cards)
+{
+    std::vector<int> drawOrder(cards.size());
+    for (size_t i = 0; i < drawOrder.size(); i++) drawOrder[i] = static_cast<int>(i);
+    std::sort(drawOrder.begin(), drawOrder.end(), [&cards](int a, int b) {
+        return isAbove(cards, b, a);
+    });
+
+    std::vector<int> drawRanks(cards.size());
+    for (size_t rank = 0; rank < drawOrder.size(); rank++) drawRanks[drawOrder[rank]] = static_cast<int>(rank);
+    return drawRanks;
+}
@@ -0,0 +1,45 @@
+#ifndef __CARD_OCCLUSION_UTILS_H__
+#define __CARD_OCCLUSION_UTILS_H__
+
+#include "../configs/models/LevelConfig.h"
+#include <vector>
+
+/**
+ * @brief 卡牌遮挡计算工具类
+ * 根据主牌区卡牌的位置、尺寸和层级计算遮挡关系，填充CardConfigData::blockedBy
+ */
+class CardOcclusionUtils
+{
+public:
+    /**
+     * @brief 计算主牌区卡牌的遮挡关系
+     * 两张牌的矩形相交（边缘相接不算）且一张在另一张上层时，下层的牌被上层的牌遮挡
+     * 上下层先比较zOrder，相同时列表中靠后的牌在上层（与添加顺序一致）
+     * 使用以卡牌尺寸为格子大小的均匀网格：相交的两张牌所在格子一定相邻，
+     * 按格子排序后每张牌只需检查周围3x3个格子，整体为O(n log n)
+     *
+     * @param cards 主牌区卡牌配置列表，计算结果写入每张牌的blockedBy（按下标升序）
+     * @param cardWidth 卡牌宽度
+     * @param cardHeight 卡牌高度
+     */
+    static void computeBlockedBy(std::vector<CardConfigData>& cards, float cardWidth, float cardHeight);
+
+    /**
+     * @brief 判断卡牌a是否绘制在卡牌b的上层
+     * @param cards 卡牌配置列表
+     * @param a 卡牌a的下标
+     * @param b 卡牌b的下标
+     * @return a在b上层返回true
+     */
+    static bool isAbove(const std::vector<CardConfigData>& cards, int a, int b);
+
+    /**
+     * @brief 计算每张卡牌唯一的绘制层级
+     * 按isAbove从下到上排序后的名次，配置层级相同的牌也能区分上下，撤销后重新加入的牌能回到原来的层次
+     * @param cards 卡牌配置列表
+     * @return 每张卡牌的绘制层级，[0, n)互不相同
+     */
+    static std::vector<int> computeDrawRanks(const std::vector<CardConfigData>& cards);
+};
+
+#endif // __CARD_OCCLUSION_UTILS_H__
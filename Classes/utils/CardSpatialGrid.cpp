@@ -0,0 +1,215 @@
+#include "CardSpatialGrid.h"
+#include "../models/CardModel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+const int CardSpatialGrid::kCellLimitPerCard;
+const int CardSpatialGrid::kMinCellLimit;
+
+namespace
+{
+    /**
+     * @brief 一组卡牌矩形的包围盒
+     */
+    struct CardBounds
+    {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+        bool empty;
+
+        CardBounds() : minX(0.0f), minY(0.0f), maxX(0.0f), maxY(0.0f), empty(true) {}
+
+        void add(const Vec2f& center, float halfWidth, float halfHeight)
+        {
+            if (empty || center.x - halfWidth < minX) minX = center.x - halfWidth;
+            if (empty || center.y - halfHeight < minY) minY = center.y - halfHeight;
+            if (empty || center.x + halfWidth > maxX) maxX = center.x + halfWidth;
+            if (empty || center.y + halfHeight > maxY) maxY = center.y + halfHeight;
+            empty = false;
+        }
+
+        /**
+         * @brief 覆盖包围盒需要的格子数量，用double计算，范围很大时不会溢出；位置不是有限值时为NaN
+         */
+        double getCellCount(float cellWidth, float cellHeight) const
+        {
+            if (empty) return 0.0;
+            return (std::floor((static_cast<double>(maxX) - minX) / cellWidth) + 1.0)
+                 * (std::floor((static_cast<double>(maxY) - minY) / cellHeight) + 1.0);
+        }
+    };
+
+    float getMedian(std::vector<float>& values)
+    {
+        if (values.empty()) return 0.0f;
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values[values.size() / 2];
+    }
+}
+
+CardSpatialGrid::CardSpatialGrid()
+    : _originX(0.0f)
+    , _originY(0.0f)
+    , _cellWidth(1.0f)
+    , _cellHeight(1.0f)
+    , _halfWidth(0.0f)
+    , _halfHeight(0.0f)
+    , _columns(0)
+    , _rows(0)
+{
+}
+
+void CardSpatialGrid::build(const std::vector<CardModel*>& slots, float cardWidth, float cardHeight)
+{
+    clear();
+    if (slots.empty() || cardWidth <= 0.0f || cardHeight <= 0.0f) return;
+
+    _cellWidth = cardWidth;
+    _cellHeight = cardHeight;
+    _halfWidth = cardWidth * 0.5f;
+    _halfHeight = cardHeight * 0.5f;
+
+    const int slotCount = static_cast<int>(slots.size());
+    _slotPositions.resize(slotCount);
+    _slotZOrders.resize(slotCount);
+    CardBounds bounds;
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        _slotPositions[slot] = slots[slot]->getPosition();
+        _slotZOrders[slot] = slots[slot]->getZOrder();
+        bounds.add(_slotPositions[slot], _halfWidth, _halfHeight);
+    }
+
+    // 网格通常覆盖所有卡牌；个别卡牌离得很远时格子数量和内存会随之暴涨，
+    // 这时按离中位数位置从近到远把卡牌加入网格，会让格子数量超出上限的卡牌单独逐张检查
+    const double maxCellCount = std::max(kMinCellLimit, slotCount * kCellLimitPerCard);
+    std::vector<char> inGrid(slotCount, 1);
+    if (!(bounds.getCellCount(_cellWidth, _cellHeight) <= maxCellCount))
+    {
+        std::vector<float> xs;
+        std::vector<float> ys;
+        for (const Vec2f& position : _slotPositions)
+        {
+            if (!std::isfinite(position.x) || !std::isfinite(position.y)) continue;
+            xs.push_back(position.x);
+            ys.push_back(position.y);
+        }
+        const float medianX = getMedian(xs);
+        const float medianY = getMedian(ys);
+
+        // 距离以卡牌尺寸为单位，取横纵方向中较大的一个；位置不是有限值的卡牌排在最后
+        std::vector<std::pair<float, int>> order(slotCount);
+        for (int slot = 0; slot < slotCount; slot++)
+        {
+            const Vec2f& position = _slotPositions[slot];
+            const float distance = std::max(std::fabs(position.x - medianX) / _cellWidth,
+                                            std::fabs(position.y - medianY) / _cellHeight);
+            order[slot] = std::make_pair(std::isnan(distance) ? std::numeric_limits<float>::infinity() : distance, slot);
+        }
+        std::sort(order.begin(), order.end());
+
+        bounds = CardBounds();
+        for (const auto& item : order)
+        {
+            CardBounds extended = bounds;
+            extended.add(_slotPositions[item.second], _halfWidth, _halfHeight);
+            if (extended.getCellCount(_cellWidth, _cellHeight) <= maxCellCount)
+            {
+                bounds = extended;
+            }
+            else
+            {
+                inGrid[item.second] = 0;
+                _outlierSlots.push_back(item.second);
+            }
+        }
+        std::sort(_outlierSlots.begin(), _outlierSlots.end(), [this](int a, int b) { return isAbove(a, b); });
+    }
+
+    // 网格只包含完整落在包围盒内的卡牌，包围盒外的点只可能命中离群的卡牌
+    _originX = bounds.minX;
+    _originY = bounds.minY;
+    _columns = static_cast<int>(std::floor((bounds.maxX - _originX) / _cellWidth)) + 1;
+    _rows = static_cast<int>(std::floor((bounds.maxY - _originY) / _cellHeight)) + 1;
+
+    // 第一遍统计每个格子的槽位数量，第二遍填入，所有格子共用一个数组
+    const int cellCount = _columns * _rows;
+    std::vector<int> cellCounts(cellCount, 0);
+    auto getCellRange = [this](const Vec2f& position, int* cellRange) {
+        cellRange[0] = std::max(0, static_cast<int>(std::floor((position.x - _halfWidth - _originX) / _cellWidth)));
+        cellRange[1] = std::min(_columns - 1, static_cast<int>(std::floor((position.x + _halfWidth - _originX) / _cellWidth)));
+        cellRange[2] = std::max(0, static_cast<int>(std::floor((position.y - _halfHeight - _originY) / _cellHeight)));
+        cellRange[3] = std::min(_rows - 1, static_cast<int>(std::floor((position.y + _halfHeight - _originY) / _cellHeight)));
+    };
+
+    int cellRange[4];
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        if (!inGrid[slot]) continue;
+
+        getCellRange(_slotPositions[slot], cellRange);
+        for (int row = cellRange[2]; row <= cellRange[3]; row++)
+        {
+            for (int column = cellRange[0]; column <= cellRange[1]; column++)
+            {
+                cellCounts[row * _columns + column]++;
+            }
+        }
+    }
+
+    _cellStarts.resize(cellCount + 1);
+    _cellStarts[0] = 0;
+    for (int cell = 0; cell < cellCount; cell++)
+    {
+        _cellStarts[cell + 1] = _cellStarts[cell] + cellCounts[cell];
+    }
+
+    _cellSlots.resize(_cellStarts[cellCount]);
+    std::vector<int> cellFill(_cellStarts.begin(), _cellStarts.end() - 1);
+    for (int slot = 0; slot < slotCount; slot++)
+    {
+        if (!inGrid[slot]) continue;
+
+        getCellRange(_slotPositions[slot], cellRange);
+        for (int row = cellRange[2]; row <= cellRange[3]; row++)
+        {
+            for (int column = cellRange[0]; column <= cellRange[1]; column++)
+            {
+                _cellSlots[cellFill[row * _columns + column]++] = slot;
+            }
+        }
+    }
+
+    // 格子内按绘制顺序从上到下排列
+    for (int cell = 0; cell < cellCount; cell++)
+    {
+        std::sort(_cellSlots.begin() + _cellStarts[cell], _cellSlots.begin() + _cellStarts[cell + 1],
+                  [this](int a, int b) { return isAbove(a, b); });
+    }
+}
+
+void CardSpatialGrid::clear()
+{
+    _columns = 0;
+    _rows = 0;
+    _cellStarts.clear();
+    _cellSlots.clear();
+    _slotPositions.clear();
+    _slotZOrders.clear();
+    _outlierSlots.clear();
+}
+
+int CardSpatialGrid::getCellIndex(const Vec2f& point) const
+{
+    if (_columns == 0 || _rows == 0) return -1;
+
+    const float x = (point.x - _originX) / _cellWidth;
+    const float y = (point.y - _originY) / _cellHeight;
+    if (!(x >= 0.0f && y >= 0.0f && x < _columns && y < _rows)) return -1;
+
+    return static_cast<int>(y) * _columns + static_cast<int>(x);
+}
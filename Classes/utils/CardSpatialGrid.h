@@ -0,0 +1,119 @@
+#ifndef __CARD_SPATIAL_GRID_H__
+#define __CARD_SPATIAL_GRID_H__
+
+#include "Vec2f.h"
+#include <vector>
+
+class CardModel;
+
+/**
+ * @brief 主牌区卡牌的空间索引，用于点击命中检测
+ * 均匀网格，格子大小等于卡牌尺寸，每张牌最多落在相邻的4个格子中
+ * 每个格子中的槽位按zOrder从上到下排列，一次查询只看点所在的一个格子，平均耗时与卡牌数量无关
+ * 格子数量不超过卡牌数量的kCellLimitPerCard倍（至少kMinCellLimit个），远离其他卡牌、会让网格超出上限的卡牌不放入网格，查询时逐张检查
+ * 主牌区卡牌的位置在一局内不变，开局时构建一次；卡牌是否还在主牌区、能否点击由查询时的条件判断
+ */
+class CardSpatialGrid
+{
+public:
+    static const int kCellLimitPerCard = 4;     // 格子数量上限相对卡牌数量的倍数
+    static const int kMinCellLimit = 64;        // 卡牌很少时的格子数量上限
+
+    CardSpatialGrid();
+
+    /**
+     * @brief 按主牌区槽位构建索引
+     * @param slots 主牌区槽位（见GameModel::getPlayfieldSlots），按卡牌位置和zOrder建立索引
+     * @param cardWidth 卡牌宽度
+     * @param cardHeight 卡牌高度
+     */
+    void build(const std::vector<CardModel*>& slots, float cardWidth, float cardHeight);
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 获取网格的格子数量
+     */
+    int getCellCount() const { return _columns * _rows; }
+
+    /**
+     * @brief 获取不在网格中、查询时逐张检查的卡牌数量
+     */
+    int getOutlierCount() const { return static_cast<int>(_outlierSlots.size()); }
+
+    /**
+     * @brief 查找包含指定点、满足条件的最上层卡牌
+     * 卡牌矩形以卡牌位置为中心，边缘上的点也算命中
+     * @param point 主牌区坐标系下的点
+     * @param accept 判断槽位能否被命中的条件，形如bool(int slot)，如卡牌还在主牌区且可点击
+     * @return 槽位下标，没有命中返回-1
+     */
+    template <typename Predicate>
+    int findTopmost(const Vec2f& point, const Predicate& accept) const
+    {
+        int topmost = -1;
+        const int cell = getCellIndex(point);
+        if (cell >= 0)
+        {
+            for (int i = _cellStarts[cell]; i < _cellStarts[cell + 1]; i++)
+            {
+                const int slot = _cellSlots[i];
+                if (containsPoint(slot, point) && accept(slot))
+                {
+                    topmost = slot;
+                    break;
+                }
+            }
+        }
+
+        // 离群的卡牌同样按从上到下排列，比网格中命中的卡牌低时不用再往下找
+        for (int slot : _outlierSlots)
+        {
+            if (topmost >= 0 && !isAbove(slot, topmost)) break;
+            if (containsPoint(slot, point) && accept(slot)) return slot;
+        }
+        return topmost;
+    }
+
+private:
+    bool containsPoint(int slot, const Vec2f& point) const
+    {
+        const Vec2f& center = _slotPositions[slot];
+        return point.x >= center.x - _halfWidth && point.x <= center.x + _halfWidth
+            && point.y >= center.y - _halfHeight && point.y <= center.y + _halfHeight;
+    }
+
+    /**
+     * @brief 槽位a是否绘制在槽位b上面：zOrder大的在上，相同时后加入的在上
+     */
+    bool isAbove(int a, int b) const
+    {
+        return _slotZOrders[a] != _slotZOrders[b] ? _slotZOrders[a] > _slotZOrders[b] : a > b;
+    }
+
+    /**
+     * @brief 获取点所在的格子
+     * @return 格子下标，点在网格范围外返回-1
+     */
+    int getCellIndex(const Vec2f& point) const;
+
+private:
+    float _originX;                     // 网格左下角
+    float _originY;
+    float _cellWidth;                   // 格子大小（卡牌尺寸）
+    float _cellHeight;
+    float _halfWidth;                   // 卡牌尺寸的一半
+    float _halfHeight;
+    int _columns;                       // 格子列数
+    int _rows;                          // 格子行数
+    std::vector<int> _cellStarts;       // 每个格子在_cellSlots中的起始下标，末尾多一个结束下标
+    std::vector<int> _cellSlots;        // 各格子中的槽位，格子内按zOrder从上到下排列
+    std::vector<Vec2f> _slotPositions;  // 按槽位下标的卡牌位置
+    std::vector<int> _slotZOrders;      // 按槽位下标的卡牌zOrder
+    std::vector<int> _outlierSlots;     // 不在网格中的槽位，按zOrder从上到下排列
+};
+
+#endif // __CARD_SPATIAL_GRID_H__
@@ -0,0 +1,25 @@
+#ifndef __COCOS_VEC_ADAPTER_H__
+#define __COCOS_VEC_ADAPTER_H__
+
+#include "cocos2d.h"
+#include "Vec2f.h"
+
+/**
+ * @brief Vec2f与cocos2d::Vec2的转换
+ * 只在视图层和控制器中使用，数据层不包含此头文件，保持不依赖引擎
+ */
+class CocosVecAdapter
+{
+public:
+    /**
+     * @brief 转换为引擎坐标
+     */
+    static cocos2d::Vec2 toCocos(const Vec2f& position) { return cocos2d::Vec2(position.x, position.y); }
+
+    /**
+     * @brief 从引擎坐标转换
+     */
+    static Vec2f fromCocos(const cocos2d::Vec2& position) { return Vec2f(position.x, position.y); }
+};
+
+#endif // __COCOS_VEC_ADAPTER_H__
@@ -0,0 +1,16 @@
+#ifndef __LOG_UTILS_H__
+#define __LOG_UTILS_H__
+
+/**
+ * @brief 日志输出
+ * 游戏中转发到CCLOG；定义GAME_CORE_HEADLESS（不带引擎的核心库构建）时输出到stderr
+ */
+#ifdef GAME_CORE_HEADLESS
+#include <cstdio>
+#define GAME_LOG(format, ...) std::fprintf(stderr, format "\n", ##__VA_ARGS__)
+#else
+#include "cocos2d.h"
+#define GAME_LOG(format, ...) CCLOG(format, ##__VA_ARGS__)
+#endif
+
+#endif // __LOG_UTILS_H__
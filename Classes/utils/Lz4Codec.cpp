@@ -0,0 +1,155 @@
+#include "Lz4Codec.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const size_t kMinMatch = 4;             // 最短匹配长度
+    const size_t kLastLiterals = 5;         // 块末尾必须是字面量的字节数
+    const size_t kMatchFindLimit = 12;      // 块末尾不再开始匹配的字节数
+    const size_t kMaxOffset = 65535;        // 匹配距离上限
+    const int kHashLog = 12;                // 哈希表大小的以2为底的对数
+
+    uint32_t read32(const uint8_t* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hashSequence(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - kHashLog);
+    }
+}
+
+std::string Lz4Codec::compress(const void* data, size_t size)
+{
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    std::string out;
+    out.reserve(size + size / 255 + 16);
+
+    size_t anchor = 0;
+    if (size > kMatchFindLimit)
+    {
+        // 记录每个哈希值最近一次出现的位置+1，0表示没有
+        std::vector<uint32_t> table(static_cast<size_t>(1) << kHashLog, 0);
+        const size_t matchStartLimit = size - kMatchFindLimit;
+        const size_t matchEndLimit = size - kLastLiterals;
+
+        size_t pos = 0;
+        while (pos < matchStartLimit)
+        {
+            const uint32_t sequence = read32(src + pos);
+            uint32_t& slot = table[hashSequence(sequence)];
+            const size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos - (candidate - 1) > kMaxOffset || read32(src + candidate - 1) != sequence)
+            {
+                pos++;
+                continue;
+            }
+
+            const size_t matchPos = candidate - 1;
+            size_t matchLength = kMinMatch;
+            while (pos + matchLength < matchEndLimit && src[matchPos + matchLength] == src[pos + matchLength])
+            {
+                matchLength++;
+            }
+
+            appendSequence(out, src + anchor, pos - anchor, pos - matchPos, matchLength);
+            pos += matchLength;
+            anchor = pos;
+        }
+    }
+
+    appendSequence(out, src + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool Lz4Codec::decompress(const void* data, size_t size, void* output, size_t outputSize)
+{
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    const uint8_t* const inEnd = in + size;
+    uint8_t* const outBegin = static_cast<uint8_t*>(output);
+    uint8_t* out = outBegin;
+    uint8_t* const outEnd = outBegin + outputSize;
+
+    // 读取扩展长度，每个字节累加，直到遇到不是255的字节
+    auto readLength = [&in, inEnd](size_t& length) {
+        uint8_t byte;
+        do
+        {
+            if (in >= inEnd) return false;
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (in < inEnd)
+    {
+        const uint8_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out))
+        {
+            return false;
+        }
+        if (literalLength > 0) std::memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        // 最后一个序列只有字面量
+        if (in == inEnd) break;
+
+        if (inEnd - in < 2) return false;
+        const size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - outBegin)) return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        matchLength += kMinMatch;
+        if (matchLength > static_cast<size_t>(outEnd - out)) return false;
+
+        // 匹配可以与输出重叠（距离小于长度时重复前面的内容），逐字节复制
+        const uint8_t* match = out - offset;
+        for (size_t i = 0; i < matchLength; i++)
+        {
+            out[i] = match[i];
+        }
+        out += matchLength;
+    }
+
+    return out == outEnd;
+}
+
+void Lz4Codec::appendLength(std::string& out, size_t length)
+{
+    while (length >= 255)
+    {
+        out += static_cast<char>(255);
+        length -= 255;
+    }
+    out += static_cast<char>(length);
+}
+
+void Lz4Codec::appendSequence(std::string& out, const uint8_t* literals, size_t literalLength,
+                              size_t offset, size_t matchLength)
+{
+    const size_t matchCode = matchLength >= kMinMatch ? matchLength - kMinMatch : 0;
+    const uint8_t token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4)
+                                               | (matchCode < 15 ? matchCode : 15));
+    out += static_cast<char>(token);
+    if (literalLength >= 15) appendLength(out, literalLength - 15);
+    out.append(reinterpret_cast<const char*>(literals), literalLength);
+
+    if (matchLength == 0) return;
+
+    out += static_cast<char>(offset & 0xFF);
+    out += static_cast<char>((offset >> 8) & 0xFF);
+    if (matchCode >= 15) appendLength(out, matchCode - 15);
+}
@@ -0,0 +1,48 @@
+#ifndef __LZ4_CODEC_H__
+#define __LZ4_CODEC_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief LZ4块格式的压缩和解压
+ * 输出与LZ4块格式（不含帧头）兼容，可用lz4库的LZ4_decompress_safe解压
+ * 压缩使用单次哈希查找的贪心匹配，偏重解压速度；解压对输入做完整的越界检查，损坏的数据只会返回失败
+ * 这是一个无状态的工具类
+ */
+class Lz4Codec
+{
+public:
+    /**
+     * @brief 压缩一块数据
+     * @param data 原始数据
+     * @param size 原始数据字节数
+     * @return 压缩后的数据，最坏情况下比原始数据略大
+     */
+    static std::string compress(const void* data, size_t size);
+
+    /**
+     * @brief 解压一块数据
+     * @param data 压缩数据
+     * @param size 压缩数据字节数
+     * @param output 输出缓冲
+     * @param outputSize 原始数据字节数，解压结果必须恰好填满输出缓冲
+     * @return 成功返回true，数据损坏或长度不符时返回false
+     */
+    static bool decompress(const void* data, size_t size, void* output, size_t outputSize);
+
+private:
+    /**
+     * @brief 追加长度的扩展字节（长度字段已满15时使用）
+     */
+    static void appendLength(std::string& out, size_t length);
+
+    /**
+     * @brief 追加一个序列：字面量，以及可选的匹配（matchLength为0表示最后一个只有字面量的序列）
+     */
+    static void appendSequence(std::string& out, const uint8_t* literals, size_t literalLength,
+                               size_t offset, size_t matchLength);
+};
+
+#endif // __LZ4_CODEC_H__
@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : _data(nullptr)
+    , _size(0)
+    , _mapping(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat fileStat;
+        void* mapping = MAP_FAILED;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+
+        if (mapping != MAP_FAILED)
+        {
+            _mapping = mapping;
+            _data = static_cast<const uint8_t*>(mapping);
+            _size = static_cast<size_t>(fileStat.st_size);
+            return true;
+        }
+    }
+#endif
+
+    // 无法映射时整体读入对齐缓冲
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    const std::streamoff size = file.tellg();
+    if (size <= 0) return false;
+
+    _buffer.resize((static_cast<size_t>(size) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(_buffer.data()), size))
+    {
+        close();
+        return false;
+    }
+
+    _data = reinterpret_cast<const uint8_t*>(_buffer.data());
+    _size = static_cast<size_t>(size);
+    return true;
+}
+
+bool MappedFile::assign(const void* data, size_t size)
+{
+    close();
+    if (!data || size == 0) return false;
+
+    _buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    std::memcpy(_buffer.data(), data, size);
+    _data = reinterpret_cast<const uint8_t*>(_buffer.data());
+    _size = size;
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifndef _WIN32
+    if (_mapping)
+    {
+        munmap(_mapping, _size);
+    }
+#endif
+    _mapping = nullptr;
+    _data = nullptr;
+    _size = 0;
+    std::vector<uint64_t>().swap(_buffer);
+}
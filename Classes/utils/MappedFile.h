@@ -0,0 +1,68 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 只读的文件内存映射
+ * POSIX平台用mmap映射整个文件，不复制内容；无法映射时（如Windows或Android安装包内的资源）
+ * 退化为读入一块8字节对齐的缓冲，同样只分配一次
+ * 数据在close或对象销毁前有效
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+     * @brief 映射文件
+     * @param path 文件路径
+     * @return 成功返回true，文件不存在或为空时返回false
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 复制一块内存作为文件内容
+     * 用于引擎只能以内存形式提供资源文件的平台
+     * @param data 数据指针
+     * @param size 数据字节数
+     * @return 成功返回true，数据为空时返回false
+     */
+    bool assign(const void* data, size_t size);
+
+    /**
+     * @brief 解除映射并释放缓冲
+     */
+    void close();
+
+    /**
+     * @brief 获取文件内容，起始地址至少8字节对齐
+     */
+    const uint8_t* getData() const { return _data; }
+
+    /**
+     * @brief 获取文件字节数
+     */
+    size_t getSize() const { return _size; }
+
+    /**
+     * @brief 判断内容是否来自mmap（而不是复制的缓冲）
+     */
+    bool isMapped() const { return _mapping != nullptr; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    const uint8_t* _data;           // 文件内容
+    size_t _size;                   // 文件字节数
+    void* _mapping;                 // mmap返回的地址，未映射时为nullptr
+    std::vector<uint64_t> _buffer;  // 无法映射时的对齐缓冲
+};
+
+#endif // __MAPPED_FILE_H__
@@ -0,0 +1,294 @@
+#include "TraceUtils.h"
+
+#ifdef GAME_ENABLE_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    const uint32_t kEventSpan = 0;
+    const uint32_t kEventCounter = 1;
+    const uint32_t kEventInstant = 2;
+    const uint32_t kEventHasValue = 0x100;      // 与事件类型按位或，表示附带参数
+
+    static_assert((TraceUtils::kBufferCapacity & (TraceUtils::kBufferCapacity - 1)) == 0,
+                  "trace buffer capacity must be a power of two");
+
+    /**
+     * @brief 环形缓冲区中的一个事件
+     * 以序号做顺序锁：写入第index个事件时先把sequence设为2*index+1，写完设为2*index+2，
+     * 读取前后两次看到的sequence相同且为2*index+2时，读到的才是完整的第index个事件
+     * 字段都是原子变量，只用relaxed读写，在常见平台上与普通读写的开销相同
+     */
+    struct TraceSlot
+    {
+        std::atomic<uint64_t> sequence;
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> timestamp;
+        std::atomic<uint64_t> duration;
+        std::atomic<int64_t> value;
+        std::atomic<uint32_t> type;
+    };
+
+    /**
+     * @brief 单个线程的环形缓冲区，只由所属线程写入
+     */
+    struct TraceBuffer
+    {
+        TraceSlot slots[TraceUtils::kBufferCapacity];
+        std::atomic<uint64_t> writeIndex;       // 下一个事件的序号
+        std::atomic<uint64_t> clearedIndex;     // clear之前的事件不再导出
+        std::atomic<const char*> threadName;
+        int threadId;
+
+        explicit TraceBuffer(int id) : writeIndex(0), clearedIndex(0), threadName(nullptr), threadId(id)
+        {
+            for (auto& slot : slots) slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief 导出时复制出的事件
+     */
+    struct TraceRecord
+    {
+        const char* name;
+        uint64_t timestamp;
+        uint64_t duration;
+        int64_t value;
+        uint32_t type;
+    };
+
+    std::mutex& getRegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<std::unique_ptr<TraceBuffer>>& getRegistry()
+    {
+        static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+        return buffers;
+    }
+
+    /**
+     * @brief 获取当前线程的缓冲区，第一次调用时注册（只有这一次加锁）
+     */
+    TraceBuffer* getThreadBuffer()
+    {
+        thread_local TraceBuffer* buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard<std::mutex> lock(getRegistryMutex());
+            auto& buffers = getRegistry();
+            buffers.emplace_back(new TraceBuffer(static_cast<int>(buffers.size()) + 1));
+            buffer = buffers.back().get();
+        }
+        return buffer;
+    }
+
+    void writeEvent(uint32_t type, const char* name, uint64_t timestamp, uint64_t duration, int64_t value)
+    {
+        TraceBuffer* buffer = getThreadBuffer();
+        const uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+        TraceSlot& slot = buffer->slots[index & (TraceUtils::kBufferCapacity - 1)];
+
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.timestamp.store(timestamp, std::memory_order_relaxed);
+        slot.duration.store(duration, std::memory_order_relaxed);
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.type.store(type, std::memory_order_relaxed);
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+
+        buffer->writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 复制缓冲区中仍然有效的事件，跳过已被覆盖或正在写入的
+     */
+    void readEvents(const TraceBuffer& buffer, std::vector<TraceRecord>& outRecords)
+    {
+        const uint64_t end = buffer.writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = buffer.clearedIndex.load(std::memory_order_acquire);
+        if (end > TraceUtils::kBufferCapacity && begin < end - TraceUtils::kBufferCapacity)
+        {
+            begin = end - TraceUtils::kBufferCapacity;
+        }
+
+        for (uint64_t index = begin; index < end; index++)
+        {
+            const TraceSlot& slot = buffer.slots[index & (TraceUtils::kBufferCapacity - 1)];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != index * 2 + 2) continue;
+
+            TraceRecord record;
+            record.name = slot.name.load(std::memory_order_relaxed);
+            record.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+            record.duration = slot.duration.load(std::memory_order_relaxed);
+            record.value = slot.value.load(std::memory_order_relaxed);
+            record.type = slot.type.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+            outRecords.push_back(record);
+        }
+    }
+
+    void appendJsonString(std::string& json, const char* str)
+    {
+        json += '"';
+        for (const char* p = str ? str : ""; *p; p++)
+        {
+            const unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"' || c == '\\')
+            {
+                json += '\\';
+                json += static_cast<char>(c);
+            }
+            else if (c < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                json += escaped;
+            }
+            else
+            {
+                json += static_cast<char>(c);
+            }
+        }
+        json += '"';
+    }
+
+    /**
+     * @brief 纳秒转换为trace_event使用的微秒
+     */
+    void appendMicroseconds(std::string& json, uint64_t nanoseconds)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%llu.%03u", static_cast<unsigned long long>(nanoseconds / 1000),
+                 static_cast<unsigned>(nanoseconds % 1000));
+        json += buffer;
+    }
+
+    void appendRecord(std::string& json, const TraceRecord& record, int threadId)
+    {
+        static const char* kPhases[] = {"X", "C", "i"};
+        const uint32_t eventType = record.type & 0xFF;
+
+        json += "{\"name\":";
+        appendJsonString(json, record.name);
+        json += ",\"cat\":\"game\",\"ph\":\"";
+        json += kPhases[eventType <= kEventInstant ? eventType : kEventInstant];
+        json += "\",\"pid\":1,\"tid\":";
+        json += std::to_string(threadId);
+        json += ",\"ts\":";
+        appendMicroseconds(json, record.timestamp);
+        if (eventType == kEventSpan)
+        {
+            json += ",\"dur\":";
+            appendMicroseconds(json, record.duration);
+        }
+        else if (eventType == kEventInstant)
+        {
+            json += ",\"s\":\"t\"";
+        }
+        if (eventType == kEventCounter || (record.type & kEventHasValue))
+        {
+            json += ",\"args\":{\"value\":";
+            json += std::to_string(record.value);
+            json += '}';
+        }
+        json += '}';
+    }
+}
+
+uint64_t TraceUtils::now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void TraceUtils::recordSpan(const char* name, uint64_t beginTime, uint64_t endTime, bool hasValue, int64_t value)
+{
+    writeEvent(kEventSpan | (hasValue ? kEventHasValue : 0), name, beginTime,
+               endTime > beginTime ? endTime - beginTime : 0, value);
+}
+
+void TraceUtils::recordCounter(const char* name, int64_t value)
+{
+    writeEvent(kEventCounter, name, now(), 0, value);
+}
+
+void TraceUtils::recordInstant(const char* name, bool hasValue, int64_t value)
+{
+    writeEvent(kEventInstant | (hasValue ? kEventHasValue : 0), name, now(), 0, value);
+}
+
+void TraceUtils::setThreadName(const char* name)
+{
+    getThreadBuffer()->threadName.store(name, std::memory_order_release);
+}
+
+std::string TraceUtils::exportChromeTrace()
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    std::vector<TraceRecord> records;
+    for (const auto& buffer : getRegistry())
+    {
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+        if (threadName)
+        {
+            if (!first) json += ',';
+            first = false;
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            json += std::to_string(buffer->threadId);
+            json += ",\"args\":{\"name\":";
+            appendJsonString(json, threadName);
+            json += "}}";
+        }
+
+        records.clear();
+        readEvents(*buffer, records);
+        for (const auto& record : records)
+        {
+            if (!first) json += ',';
+            first = false;
+            appendRecord(json, record, buffer->threadId);
+        }
+    }
+
+    json += "]}\n";
+    return json;
+}
+
+bool TraceUtils::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+    if (!file) return false;
+
+    file << exportChromeTrace();
+    return static_cast<bool>(file);
+}
+
+void TraceUtils::clear()
+{
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    for (const auto& buffer : getRegistry())
+    {
+        buffer->clearedIndex.store(buffer->writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
+
+#endif // GAME_ENABLE_TRACE
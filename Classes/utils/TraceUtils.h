@@ -0,0 +1,137 @@
+#ifndef __TRACE_UTILS_H__
+#define __TRACE_UTILS_H__
+
+/**
+ * @brief 性能跟踪
+ * 定义GAME_ENABLE_TRACE时记录耗时区间、计数器和瞬时事件，按需导出为Chrome trace_event格式的JSON，
+ * 可在chrome://tracing或Perfetto中打开；未定义时下面的宏全部展开为空，参数也不会求值
+ *
+ *   GAME_TRACE_SCOPE("parseLevelConfig");             // 记录到所在作用域结束的耗时区间
+ *   GAME_TRACE_SCOPE_VALUE("loadGameModel", levelId); // 同上，附带一个整数参数
+ *   GAME_TRACE_COUNTER("cardViewPoolFree", count);    // 计数器，在时间线上显示为曲线
+ *   GAME_TRACE_INSTANT_VALUE("moveAnimationDone", cardId);   // 瞬时事件
+ *   GAME_TRACE_THREAD_NAME("LevelPrefetch");          // 导出时显示的线程名
+ *   GAME_TRACE_WRITE(path);                           // 导出到文件
+ *
+ * 事件名和线程名必须是字符串字面量（只保存指针）
+ */
+#ifdef GAME_ENABLE_TRACE
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 跟踪事件的记录和导出
+ * 每个线程第一次记录时分配自己的环形缓冲区，之后只由该线程写入，记录时不加锁
+ * 缓冲区写满后覆盖最早的事件；导出可以在任意线程进行，与写入并发时跳过正在被覆盖的事件
+ * 线程退出后缓冲区保留，已记录的事件仍可导出
+ */
+class TraceUtils
+{
+public:
+    static const int kBufferCapacity = 8192;    // 每个线程保留的事件数量，必须是2的幂
+
+    /**
+     * @brief 获取当前时间（纳秒，从第一次调用起计时）
+     */
+    static uint64_t now();
+
+    /**
+     * @brief 记录耗时区间
+     * @param name 事件名
+     * @param beginTime 开始时间（now()的返回值）
+     * @param endTime 结束时间
+     * @param hasValue 是否附带参数
+     * @param value 参数
+     */
+    static void recordSpan(const char* name, uint64_t beginTime, uint64_t endTime, bool hasValue, int64_t value);
+
+    /**
+     * @brief 记录计数器的当前值
+     * @param name 计数器名
+     * @param value 计数器的值
+     */
+    static void recordCounter(const char* name, int64_t value);
+
+    /**
+     * @brief 记录瞬时事件
+     * @param name 事件名
+     * @param hasValue 是否附带参数
+     * @param value 参数
+     */
+    static void recordInstant(const char* name, bool hasValue, int64_t value);
+
+    /**
+     * @brief 设置当前线程在导出结果中显示的名字
+     * @param name 线程名
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * @brief 导出所有线程缓冲区中的事件
+     * @return Chrome trace_event格式的JSON
+     */
+    static std::string exportChromeTrace();
+
+    /**
+     * @brief 导出到文件
+     * @param path 文件路径
+     * @return 成功返回true
+     */
+    static bool writeChromeTrace(const std::string& path);
+
+    /**
+     * @brief 丢弃已记录的事件，之后导出只包含新的事件
+     */
+    static void clear();
+};
+
+/**
+ * @brief 耗时区间，构造时记下开始时间，析构时记录整个区间
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name)
+        : _name(name), _beginTime(TraceUtils::now()), _hasValue(false), _value(0) {}
+
+    TraceScope(const char* name, int64_t value)
+        : _name(name), _beginTime(TraceUtils::now()), _hasValue(true), _value(value) {}
+
+    ~TraceScope() { TraceUtils::recordSpan(_name, _beginTime, TraceUtils::now(), _hasValue, _value); }
+
+private:
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    const char* _name;
+    uint64_t _beginTime;
+    bool _hasValue;
+    int64_t _value;
+};
+
+#define GAME_TRACE_CONCAT_IMPL(a, b) a##b
+#define GAME_TRACE_CONCAT(a, b) GAME_TRACE_CONCAT_IMPL(a, b)
+
+#define GAME_TRACE_SCOPE(name) TraceScope GAME_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define GAME_TRACE_SCOPE_VALUE(name, value) \
+    TraceScope GAME_TRACE_CONCAT(traceScope, __LINE__)(name, static_cast<int64_t>(value))
+#define GAME_TRACE_COUNTER(name, value) TraceUtils::recordCounter(name, static_cast<int64_t>(value))
+#define GAME_TRACE_INSTANT(name) TraceUtils::recordInstant(name, false, 0)
+#define GAME_TRACE_INSTANT_VALUE(name, value) TraceUtils::recordInstant(name, true, static_cast<int64_t>(value))
+#define GAME_TRACE_THREAD_NAME(name) TraceUtils::setThreadName(name)
+#define GAME_TRACE_WRITE(path) TraceUtils::writeChromeTrace(path)
+
+#else
+
+#define GAME_TRACE_SCOPE(name) ((void)0)
+#define GAME_TRACE_SCOPE_VALUE(name, value) ((void)0)
+#define GAME_TRACE_COUNTER(name, value) ((void)0)
+#define GAME_TRACE_INSTANT(name) ((void)0)
+#define GAME_TRACE_INSTANT_VALUE(name, value) ((void)0)
+#define GAME_TRACE_THREAD_NAME(name) ((void)0)
+#define GAME_TRACE_WRITE(path) ((void)0)
+
+#endif // GAME_ENABLE_TRACE
+
+#endif // __TRACE_UTILS_H__
@@ -0,0 +1,58 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(int log2Capacity)
+    : _mask((static_cast<size_t>(1) << log2Capacity) - 1)
+{
+    _entries.reset(new std::atomic<uint64_t>[_mask + 1]);
+    clear();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+}
+
+bool TranspositionTable::insert(uint64_t hash)
+{
+    const uint64_t entry = toEntry(hash);
+    const size_t base = static_cast<size_t>(entry) & _mask;
+
+    for (size_t i = 0; i < kProbeCount; i++)
+    {
+        std::atomic<uint64_t>& slot = _entries[(base + i) & _mask];
+        uint64_t current = slot.load(std::memory_order_relaxed);
+        if (current == entry) return false;
+
+        if (current == 0)
+        {
+            // 空槽位：抢占失败时再检查一次，可能正是另一个线程写入了同一局面
+            if (slot.compare_exchange_strong(current, entry, std::memory_order_relaxed)) return true;
+            if (current == entry) return false;
+        }
+    }
+
+    // 探测范围已满，按哈希高位选择一个槽位覆盖
+    _entries[(base + (entry >> 62)) & _mask].store(entry, std::memory_order_relaxed);
+    return true;
+}
+
+bool TranspositionTable::contains(uint64_t hash) const
+{
+    const uint64_t entry = toEntry(hash);
+    const size_t base = static_cast<size_t>(entry) & _mask;
+
+    for (size_t i = 0; i < kProbeCount; i++)
+    {
+        uint64_t current = _entries[(base + i) & _mask].load(std::memory_order_relaxed);
+        if (current == entry) return true;
+        if (current == 0) return false;
+    }
+    return false;
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i <= _mask; i++)
+    {
+        _entries[i].store(0, std::memory_order_relaxed);
+    }
+}
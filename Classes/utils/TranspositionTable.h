@@ -0,0 +1,67 @@
+#ifndef __TRANSPOSITION_TABLE_H__
+#define __TRANSPOSITION_TABLE_H__
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief 置换表
+ * 以局面的Zobrist哈希为键，记录搜索中已经展开过的局面
+ * 固定大小，不会扩容；每个哈希在相邻的4个槽位中探测，槽位满时覆盖其中一个旧记录
+ * 所有操作无锁，可被多个搜索线程同时使用
+ * 旧记录被覆盖后局面会被重复展开，不影响搜索结果，但表中的记录远多于槽位数量时，
+ * 被覆盖的局面下的整棵子树都要重新搜索，搜索量可能成倍甚至指数增长；容量须按关卡规模选取
+ * 单线程搜索应使用不丢失记录的VisitedStateSet
+ */
+class TranspositionTable
+{
+public:
+    /**
+     * @brief 构造置换表
+     * @param log2Capacity 槽位数量的以2为底的对数，例如20表示1M个槽位（8MB）
+     */
+    explicit TranspositionTable(int log2Capacity);
+    ~TranspositionTable();
+
+    /**
+     * @brief 记录一个局面
+     * @param hash 局面哈希
+     * @return 局面之前不在表中返回true，已存在返回false
+     */
+    bool insert(uint64_t hash);
+
+    /**
+     * @brief 判断局面是否在表中
+     * @param hash 局面哈希
+     * @return 在表中返回true
+     */
+    bool contains(uint64_t hash) const;
+
+    /**
+     * @brief 清空所有记录（不可与insert并发调用）
+     */
+    void clear();
+
+    /**
+     * @brief 获取槽位数量
+     */
+    size_t getCapacity() const { return _mask + 1; }
+
+private:
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief 将哈希转换为槽位中保存的值（0表示空槽位）
+     */
+    static uint64_t toEntry(uint64_t hash) { return hash ? hash : 1; }
+
+    static const size_t kProbeCount = 4;        // 每个哈希探测的槽位数量
+
+    std::unique_ptr<std::atomic<uint64_t>[]> _entries;  // 槽位数组
+    size_t _mask;                                       // 槽位下标掩码
+};
+
+#endif // __TRANSPOSITION_TABLE_H__
@@ -0,0 +1,25 @@
+#ifndef __VEC2F_H__
+#define __VEC2F_H__
+
+#include <type_traits>
+
+/**
+ * @brief 二维坐标
+ * 数据层和规则层使用的坐标类型，可平凡拷贝，不依赖引擎
+ * 与cocos2d::Vec2之间的转换见CocosVecAdapter
+ */
+struct Vec2f
+{
+    float x;
+    float y;
+
+    Vec2f() : x(0.0f), y(0.0f) {}
+    Vec2f(float xValue, float yValue) : x(xValue), y(yValue) {}
+
+    bool operator==(const Vec2f& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const Vec2f& other) const { return !(*this == other); }
+};
+
+static_assert(std::is_trivially_copyable<Vec2f>::value, "Vec2f must stay trivially copyable");
+
+#endif // __VEC2F_H__
@@ -0,0 +1,63 @@
+#include "VisitedStateSet.h"
+
+VisitedStateSet::VisitedStateSet(int log2InitialCapacity)
+    : _entries(static_cast<size_t>(1) << log2InitialCapacity, 0)
+    , _mask((static_cast<size_t>(1) << log2InitialCapacity) - 1)
+    , _size(0)
+{
+}
+
+bool VisitedStateSet::insert(uint64_t hash)
+{
+    // 装载率不超过一半，线性探测的平均探测次数保持在2次以内
+    if ((_size + 1) * 2 > _entries.size()) grow();
+
+    const uint64_t entry = toEntry(hash);
+    size_t index = static_cast<size_t>(entry) & _mask;
+    while (_entries[index] != 0)
+    {
+        if (_entries[index] == entry) return false;
+        index = (index + 1) & _mask;
+    }
+
+    _entries[index] = entry;
+    _size++;
+    return true;
+}
+
+bool VisitedStateSet::contains(uint64_t hash) const
+{
+    const uint64_t entry = toEntry(hash);
+    size_t index = static_cast<size_t>(entry) & _mask;
+    while (_entries[index] != 0)
+    {
+        if (_entries[index] == entry) return true;
+        index = (index + 1) & _mask;
+    }
+    return false;
+}
+
+void VisitedStateSet::clear()
+{
+    _entries.assign(_entries.size(), 0);
+    _size = 0;
+}
+
+void VisitedStateSet::grow()
+{
+    std::vector<uint64_t> oldEntries(_entries.size() * 2, 0);
+    oldEntries.swap(_entries);
+    _mask = _entries.size() - 1;
+
+    for (uint64_t entry : oldEntries)
+    {
+        if (entry == 0) continue;
+
+        size_t index = static_cast<size_t>(entry) & _mask;
+        while (_entries[index] != 0)
+        {
+            index = (index + 1) & _mask;
+        }
+        _entries[index] = entry;
+    }
+}
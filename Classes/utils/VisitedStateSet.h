@@ -0,0 +1,68 @@
+#ifndef __VISITED_STATE_SET_H__
+#define __VISITED_STATE_SET_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 已访问局面集合
+ * 以局面的Zobrist哈希为键的开放寻址哈希集合，装载率超过一半时扩容，记录不会丢失
+ * 与TranspositionTable不同，插入过的局面总能查到，搜索不会重复展开同一局面，但内存随局面数增长
+ * 非线程安全，供单线程搜索使用
+ */
+class VisitedStateSet
+{
+public:
+    /**
+     * @brief 构造集合
+     * @param log2InitialCapacity 初始槽位数量的以2为底的对数
+     */
+    explicit VisitedStateSet(int log2InitialCapacity);
+
+    /**
+     * @brief 记录一个局面
+     * @param hash 局面哈希
+     * @return 局面之前不在集合中返回true，已存在返回false
+     */
+    bool insert(uint64_t hash);
+
+    /**
+     * @brief 判断局面是否在集合中
+     * @param hash 局面哈希
+     * @return 在集合中返回true
+     */
+    bool contains(uint64_t hash) const;
+
+    /**
+     * @brief 清空所有记录，保留已分配的槽位
+     */
+    void clear();
+
+    /**
+     * @brief 获取记录的局面数量
+     */
+    size_t getSize() const { return _size; }
+
+    /**
+     * @brief 获取槽位数量
+     */
+    size_t getCapacity() const { return _entries.size(); }
+
+private:
+    /**
+     * @brief 将哈希转换为槽位中保存的值（0表示空槽位）
+     */
+    static uint64_t toEntry(uint64_t hash) { return hash ? hash : 1; }
+
+    /**
+     * @brief 槽位数量翻倍，重新放入所有记录
+     */
+    void grow();
+
+    std::vector<uint64_t> _entries;     // 槽位数组，数量为2的幂
+    size_t _mask;                       // 槽位下标掩码
+    size_t _size;                       // 记录的局面数量
+};
+
+#endif // __VISITED_STATE_SET_H__
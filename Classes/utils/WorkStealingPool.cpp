@@ -0,0 +1,158 @@
+#include "WorkStealingPool.h"
+
+namespace
+{
+    // 当前线程所属的线程池和工作线程下标，非工作线程为nullptr
+    thread_local WorkStealingPool* t_currentPool = nullptr;
+    thread_local int t_workerIndex = -1;
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : _queuedCount(0)
+    , _pendingCount(0)
+    , _idleCount(0)
+    , _nextQueue(0)
+    , _stopping(false)
+{
+    if (threadCount < 1)
+    {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount < 1) threadCount = 1;
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        _queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        _threads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    waitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(const Task& task)
+{
+    int index = 0;
+    if (t_currentPool == this)
+    {
+        index = t_workerIndex;
+    }
+    else
+    {
+        index = static_cast<int>(_nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size());
+    }
+
+    _pendingCount.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(task);
+    }
+    _queuedCount.fetch_add(1, std::memory_order_acq_rel);
+
+    // 在锁内通知前的检查与等待线程的条件判断互斥，避免唤醒丢失
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+    }
+    _workAvailable.notify_one();
+}
+
+void WorkStealingPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(_waitMutex);
+    _allDone.wait(lock, [this]() {
+        return _pendingCount.load(std::memory_order_acquire) == 0;
+    });
+}
+
+bool WorkStealingPool::hasIdleWorker() const
+{
+    return _idleCount.load(std::memory_order_relaxed) > _queuedCount.load(std::memory_order_relaxed);
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+    t_currentPool = this;
+    t_workerIndex = index;
+
+    Task task;
+    while (true)
+    {
+        if (takeTask(index, task))
+        {
+            task();
+            task = nullptr;
+
+            if (_pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(_waitMutex);
+                _allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_waitMutex);
+        _idleCount.fetch_add(1, std::memory_order_relaxed);
+        _workAvailable.wait(lock, [this]() {
+            return _stopping || _queuedCount.load(std::memory_order_acquire) > 0;
+        });
+        _idleCount.fetch_sub(1, std::memory_order_relaxed);
+
+        if (_stopping && _queuedCount.load(std::memory_order_acquire) == 0)
+        {
+            break;
+        }
+    }
+
+    t_currentPool = nullptr;
+    t_workerIndex = -1;
+}
+
+bool WorkStealingPool::takeTask(int index, Task& outTask)
+{
+    // 自己的队列从尾部取，保持深度优先和缓存局部性
+    {
+        WorkerQueue& queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            outTask = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            _queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // 从其他线程的队列头部窃取
+    const int count = static_cast<int>(_queues.size());
+    for (int offset = 1; offset < count; offset++)
+    {
+        WorkerQueue& queue = *_queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            outTask = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            _queuedCount.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,101 @@
+#ifndef __WORK_STEALING_POOL_H__
+#define __WORK_STEALING_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 工作窃取线程池
+ * 每个工作线程有自己的任务队列：工作线程提交的任务放入自己队列的尾部并优先从尾部取出（深度优先），
+ * 自己的队列为空时从其他线程队列的头部窃取（取走最早、通常也是最大的子树）
+ * 适合搜索这类在运行中不断拆分出子任务的负载
+ */
+class WorkStealingPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * @brief 创建线程池并启动工作线程
+     * @param threadCount 工作线程数量，小于1时使用硬件线程数
+     */
+    explicit WorkStealingPool(int threadCount);
+
+    /**
+     * @brief 等待已提交的任务执行完毕后停止所有工作线程
+     */
+    ~WorkStealingPool();
+
+    /**
+     * @brief 提交一个任务
+     * 在工作线程中调用时放入该线程自己的队列，否则轮流放入各线程的队列
+     * @param task 任务
+     */
+    void submit(const Task& task);
+
+    /**
+     * @brief 阻塞等待直到所有已提交的任务（包括任务中再提交的任务）执行完毕
+     * 不能在工作线程中调用
+     */
+    void waitIdle();
+
+    /**
+     * @brief 是否有空闲的工作线程没有任务可取
+     * 任务可据此决定是否把子任务拆分出去
+     * @return 空闲线程数量多于排队任务数量时返回true
+     */
+    bool hasIdleWorker() const;
+
+    /**
+     * @brief 获取工作线程数量
+     */
+    int getThreadCount() const { return static_cast<int>(_threads.size()); }
+
+private:
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief 单个工作线程的任务队列
+     */
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief 工作线程主循环
+     * @param index 工作线程下标
+     */
+    void workerLoop(int index);
+
+    /**
+     * @brief 取出一个任务：先取自己队列的尾部，再依次窃取其他队列的头部
+     * @param index 工作线程下标
+     * @param outTask 输出参数，取到的任务
+     * @return 取到任务返回true
+     */
+    bool takeTask(int index, Task& outTask);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;  // 每个工作线程的任务队列
+    std::vector<std::thread> _threads;                  // 工作线程
+
+    std::mutex _waitMutex;                      // 保护以下两个条件变量的等待
+    std::condition_variable _workAvailable;     // 有新任务或线程池停止
+    std::condition_variable _allDone;           // 所有任务执行完毕
+
+    std::atomic<int> _queuedCount;              // 排队中尚未被取走的任务数量
+    std::atomic<int> _pendingCount;             // 尚未执行完毕的任务数量（含排队中的）
+    std::atomic<int> _idleCount;                // 正在等待任务的工作线程数量
+    std::atomic<unsigned> _nextQueue;           // 外部提交时轮流选择的队列
+    bool _stopping;                             // 是否正在停止（由_waitMutex保护）
+};
+
+#endif // __WORK_STEALING_POOL_H__
@@ -0,0 +1,33 @@
+#include "ZobristHash.h"
+
+namespace
+{
+    // 区分不同区域的键空间
+    const uint64_t kPlayfieldSeed = 0x243F6A8885A308D3ULL;
+    const uint64_t kStackSeed = 0x13198A2E03707344ULL;
+    const uint64_t kTraySeed = 0xA4093822299F31D0ULL;
+}
+
+uint64_t ZobristHash::playfieldKey(int cardId)
+{
+    return mix(kPlayfieldSeed ^ static_cast<uint64_t>(static_cast<uint32_t>(cardId)));
+}
+
+uint64_t ZobristHash::stackKey(int cardId)
+{
+    return mix(kStackSeed ^ static_cast<uint64_t>(static_cast<uint32_t>(cardId)));
+}
+
+uint64_t ZobristHash::trayKey(int face)
+{
+    if (face < 0) return 0;
+    return mix(kTraySeed ^ static_cast<uint64_t>(face));
+}
+
+uint64_t ZobristHash::mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
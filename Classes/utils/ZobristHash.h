@@ -0,0 +1,44 @@
+#ifndef __ZOBRIST_HASH_H__
+#define __ZOBRIST_HASH_H__
+
+#include <cstdint>
+
+/**
+ * @brief Zobrist哈希工具类
+ * 为"某张牌在主牌区"、"某张牌在备用牌堆"、"底牌为某点数"各分配一个64位随机键，
+ * 局面哈希为所有成立条件对应键的异或，每次移动只需异或变化的几项即可增量更新
+ * 底牌按点数而非卡牌ID取键，点数相同的底牌视为同一局面
+ */
+class ZobristHash
+{
+public:
+    /**
+     * @brief 获取卡牌位于主牌区的键
+     * @param cardId 卡牌ID
+     * @return 64位键
+     */
+    static uint64_t playfieldKey(int cardId);
+
+    /**
+     * @brief 获取卡牌位于备用牌堆的键
+     * @param cardId 卡牌ID
+     * @return 64位键
+     */
+    static uint64_t stackKey(int cardId);
+
+    /**
+     * @brief 获取底牌点数的键
+     * @param face 牌面点数 (0-A, 1-2, ..., 12-K)，没有底牌时传-1
+     * @return 64位键，没有底牌时为0
+     */
+    static uint64_t trayKey(int face);
+
+private:
+    /**
+     * @brief 由输入生成分布均匀的64位值（splitmix64）
+     * 卡牌ID没有上限，用确定性混合函数代替预生成的随机表
+     */
+    static uint64_t mix(uint64_t value);
+};
+
+#endif // __ZOBRIST_HASH_H__
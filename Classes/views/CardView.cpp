@@ -4,24 +4,29 @@
 
 USING_NS_CC;
 
-const float CardView::kCardWidth = 120.0f;
-const float CardView::kCardHeight = 160.0f;
+const float CardView::kCardWidth = CardResConfig::kCardWidth;
+const float CardView::kCardHeight = CardResConfig::kCardHeight;
+const Color3B CardView::kBlockedColor = Color3B(150, 150, 150);
+
+namespace
+{
+    bool s_cardAtlasLoaded = false;         // 卡牌图集是否已加载到SpriteFrameCache
+    bool s_cardFacesComposited = false;     // 图集中是否有合成好的完整牌面
+}
 
 CardView::CardView()
     : _cardModel(nullptr)
     , _cardId(0)
     , _cardSprite(nullptr)
-    , _touchListener(nullptr)
+    , _bigNumberSprite(nullptr)
+    , _smallNumberSprite(nullptr)
+    , _suitSprite(nullptr)
+    , _clickEnabled(true)
 {
 }
 
 CardView::~CardView()
 {
-    if (_touchListener)
-    {
-        _eventDispatcher->removeEventListener(_touchListener);
-        _touchListener = nullptr;
-    }
 }
 
 CardView* CardView::create(const CardModel* cardModel, const CardClickCallback& callback)
@@ -51,108 +56,122 @@ bool CardView::init(const CardModel* cardModel, const CardClickCallback& callbac
     setContentSize(Size(kCardWidth, kCardHeight));
     setAnchorPoint(Vec2(0.5f, 0.5f));
 
-    // 创建卡牌UI
+    // 创建卡牌UI，颜色传递给所有子精灵，遮挡显示由GameView按数据模型设置
     createCardUI();
-
-    // 设置触摸监听
-    setupTouchListener();
+    setCascadeColorEnabled(true);
 
     return true;
 }
 
-void CardView::createCardUI()
+void CardView::loadCardAtlas()
 {
-    if (!_cardModel) return;
+    if (s_cardAtlasLoaded) return;
 
-    // 创建卡牌背景
-    std::string backPath = CardResConfig::getCardBackPath();
-    _cardSprite = Sprite::create(backPath);
-    if (_cardSprite)
+    const std::string atlasPath = CardResConfig::getCardAtlasPath();
+    auto frameCache = SpriteFrameCache::getInstance();
+    if (!frameCache->isSpriteFramesWithFileLoaded(atlasPath))
     {
-        _cardSprite->setPosition(kCardWidth / 2, kCardHeight / 2);
-        addChild(_cardSprite, 0);
-    }
-    else
-    {
-        CCLOG("Failed to load card back: %s", backPath.c_str());
+        if (!FileUtils::getInstance()->isFileExist(atlasPath))
+        {
+            CCLOG("Card atlas not found, using separate textures: %s", atlasPath.c_str());
+            return;
+        }
+        frameCache->addSpriteFramesWithFile(atlasPath);
     }
+    s_cardAtlasLoaded = true;
+    s_cardFacesComposited = frameCache->getSpriteFrameByName(CardResConfig::getCardFaceFrameName(0, 0)) != nullptr;
+}
 
-    // 添加大数字（中间偏下）
-    bool isRed = _cardModel->isRed();
-    std::string bigNumPath = CardResConfig::getCardBigNumberPath(_cardModel->getFace(), isRed);
-    Sprite* bigNumSprite = Sprite::create(bigNumPath);
-    if (bigNumSprite)
-    {
-        bigNumSprite->setPosition(kCardWidth / 2, kCardHeight / 2 - 20);
-        addChild(bigNumSprite, 1);
-        CCLOG("Loaded big number: %s at position (%f, %f)", bigNumPath.c_str(), kCardWidth / 2, kCardHeight / 2 - 20);
-    }
-    else
-    {
-        CCLOG("Failed to load big number: %s", bigNumPath.c_str());
-    }
+void CardView::bind(const CardModel* cardModel, const CardClickCallback& callback)
+{
+    // 恢复为刚创建时的状态，遮挡显示和是否可点击由GameView按数据模型重新设置
+    stopAllActions();
+    setColor(Color3B::WHITE);
+    setClickEnabled(true);
 
-    // 添加小数字（左上角，更靠上）
-    std::string smallNumPath = CardResConfig::getCardSmallNumberPath(_cardModel->getFace(), isRed);
-    Sprite* smallNumSprite = Sprite::create(smallNumPath);
-    if (smallNumSprite)
+    _cardModel = cardModel;
+    _cardId = cardModel ? cardModel->getId() : 0;
+    _clickCallback = callback;
+
+    // 精灵都沿用，只切换显示的帧
+    updateCardUI();
+}
+
+void CardView::unbind()
+{
+    // 停止动画，避免动画结束回调访问已释放的控制器和数据模型
+    stopAllActions();
+    _cardModel = nullptr;
+    _clickCallback = nullptr;
+}
+
+void CardView::createCardUI()
+{
+    // 图集中有合成好的牌面时每张牌只用一个精灵，大幅减少节点数和每帧遍历的开销；
+    // 没有时由底图、大数字、小数字和花色四个精灵拼出
+    _cardSprite = addPartSprite(CardResConfig::kBackLayout, 0);
+    if (!s_cardFacesComposited)
     {
-        smallNumSprite->setPosition(15, kCardHeight - 5);
-        smallNumSprite->setScale(0.8f);
-        addChild(smallNumSprite, 2);
-        CCLOG("Loaded small number: %s at position (15, %f)", smallNumPath.c_str(), kCardHeight - 5);
+        _bigNumberSprite = addPartSprite(CardResConfig::kBigNumberLayout, 1);
+        _smallNumberSprite = addPartSprite(CardResConfig::kSmallNumberLayout, 2);
+        _suitSprite = addPartSprite(CardResConfig::kSuitLayout, 2);
     }
-    else
+
+    updateCardUI();
+}
+
+void CardView::updateCardUI()
+{
+    if (!_cardModel) return;
+
+    const int face = _cardModel->getFace();
+    const int suit = _cardModel->getSuit();
+    if (!_bigNumberSprite)
     {
-        CCLOG("Failed to load small number: %s", smallNumPath.c_str());
+        setPartImage(_cardSprite, CardResConfig::getCardFaceFrameName(face, suit));
+        return;
     }
 
-    // 添加花色图标（右上角，更靠上）
-    std::string suitPath = CardResConfig::getCardSuitPath(_cardModel->getSuit());
-    Sprite* suitSprite = Sprite::create(suitPath);
-    if (suitSprite)
+    bool isRed = _cardModel->isRed();
+    setPartImage(_cardSprite, CardResConfig::getCardBackPath());
+    setPartImage(_bigNumberSprite, CardResConfig::getCardBigNumberPath(face, isRed));
+    setPartImage(_smallNumberSprite, CardResConfig::getCardSmallNumberPath(face, isRed));
+    setPartImage(_suitSprite, CardResConfig::getCardSuitPath(suit));
+}
+
+Sprite* CardView::addPartSprite(const CardPartLayout& layout, int zOrder)
+{
+    Sprite* sprite = Sprite::create();
+    if (!sprite) return nullptr;
+
+    sprite->setPosition(layout.x, layout.y);
+    sprite->setScale(layout.scale);
+    addChild(sprite, zOrder);
+    return sprite;
+}
+
+void CardView::setPartImage(Sprite* sprite, const std::string& path)
+{
+    if (!sprite) return;
+
+    // 同一纹理、混合方式和着色器的精灵会被渲染器合并为一次绘制，部件都来自图集时整个牌面连续合批
+    SpriteFrame* frame = s_cardAtlasLoaded ? SpriteFrameCache::getInstance()->getSpriteFrameByName(path) : nullptr;
+    if (frame)
     {
-        suitSprite->setPosition(kCardWidth - 15, kCardHeight - 5);
-        suitSprite->setScale(0.6f);
-        addChild(suitSprite, 2);
-        CCLOG("Loaded suit: %s at position (%f, %f)", suitPath.c_str(), kCardWidth - 15, kCardHeight - 5);
+        sprite->setSpriteFrame(frame);
     }
     else
     {
-        CCLOG("Failed to load suit: %s", suitPath.c_str());
+        sprite->setTexture(path);
     }
 }
 
-void CardView::setupTouchListener()
+void CardView::performClick()
 {
-    _touchListener = EventListenerTouchOneByOne::create();
-    _touchListener->setSwallowTouches(true);
-
-    _touchListener->onTouchBegan = [this](Touch* touch, Event* event) -> bool {
-        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
-        Rect rect = Rect(0, 0, this->getContentSize().width, this->getContentSize().height);
-
-        if (rect.containsPoint(locationInNode))
-        {
-            return true;
-        }
-        return false;
-    };
-
-    _touchListener->onTouchEnded = [this](Touch* touch, Event* event) {
-        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
-        Rect rect = Rect(0, 0, this->getContentSize().width, this->getContentSize().height);
-
-        if (rect.containsPoint(locationInNode))
-        {
-            if (_clickCallback)
-            {
-                _clickCallback(_cardId);
-            }
-        }
-    };
-
-    _eventDispatcher->addEventListenerWithSceneGraphPriority(_touchListener, this);
+    if (_clickEnabled && _clickCallback)
+    {
+        _clickCallback(_cardId);
+    }
 }
 
 void CardView::playMoveAnimation(const Vec2& targetPos, float duration, const std::function<void()>& callback)
@@ -170,10 +189,20 @@ void CardView::playMoveAnimation(const Vec2& targetPos, float duration, const st
     }
 }
 
-void CardView::setClickEnabled(bool enabled)
+void CardView::setBlockedDisplay(bool blocked, float duration)
 {
-    if (_touchListener)
+    const Color3B& color = blocked ? kBlockedColor : Color3B::WHITE;
+    if (duration > 0)
+    {
+        runAction(TintTo::create(duration, color));
+    }
+    else
     {
-        _touchListener->setEnabled(enabled);
+        setColor(color);
     }
 }
+
+void CardView::setClickEnabled(bool enabled)
+{
+    _clickEnabled = enabled;
+}
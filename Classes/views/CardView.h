@@ -5,11 +5,12 @@
 #include <functional>
 
 class CardModel;
+struct CardPartLayout;
 
 /**
  * @brief 卡牌视图类
  * 负责单张卡牌的UI显示和交互
- * 通过回调接口与Controller交互
+ * 卡牌自身不监听触摸，由GameView统一命中检测后调用performClick，通过回调接口与Controller交互
  */
 class CardView : public cocos2d::Node
 {
@@ -35,6 +36,26 @@ public:
      */
     bool init(const CardModel* cardModel, const CardClickCallback& callback);
 
+    /**
+     * @brief 加载卡牌图集到SpriteFrameCache
+     * 所有卡牌共用一张纹理，整个牌面可以合批绘制；需在创建卡牌前调用，重复调用无开销
+     * 图集不存在时卡牌退回到逐张加载的图片
+     */
+    static void loadCardAtlas();
+
+    /**
+     * @brief 把视图重新绑定到另一张卡牌，供CardViewPool复用视图
+     * 沿用已有的精灵，只切换显示的帧，并恢复颜色、动画和可点击状态
+     * @param cardModel 卡牌数据模型（const指针）
+     * @param callback 点击回调函数
+     */
+    void bind(const CardModel* cardModel, const CardClickCallback& callback);
+
+    /**
+     * @brief 解除与卡牌数据和回调的绑定，视图回收到CardViewPool前调用
+     */
+    void unbind();
+
     /**
      * @brief 获取卡牌ID
      * @return 卡牌ID
@@ -55,26 +76,63 @@ public:
      */
     void setClickEnabled(bool enabled);
 
-private:
     /**
-     * @brief 设置触摸事件监听
+     * @brief 卡牌是否可点击
+     */
+    bool isClickEnabled() const { return _clickEnabled; }
+
+    /**
+     * @brief 处理点击：可点击时调用点击回调
+     * 由GameView的触摸命中检测调用
      */
-    void setupTouchListener();
+    void performClick();
 
     /**
-     * @brief 创建卡牌UI
+     * @brief 显示卡牌的遮挡状态，被遮挡的卡牌颜色变暗
+     * @param blocked 是否被遮挡
+     * @param duration 渐变时长，为0时立即生效
+     */
+    void setBlockedDisplay(bool blocked, float duration = 0.0f);
+
+private:
+    /**
+     * @brief 创建卡牌UI的精灵
      */
     void createCardUI();
 
+    /**
+     * @brief 按绑定的卡牌数据设置各精灵显示的帧
+     */
+    void updateCardUI();
+
+    /**
+     * @brief 按摆放创建部件精灵并加到卡牌上
+     * @param layout 部件摆放
+     * @param zOrder 部件层级
+     * @return 精灵对象，失败返回nullptr
+     */
+    cocos2d::Sprite* addPartSprite(const CardPartLayout& layout, int zOrder);
+
+    /**
+     * @brief 设置部件精灵显示的图片，优先使用图集中的帧
+     * @param sprite 部件精灵，为nullptr时忽略
+     * @param path 部件图片路径（也是图集中的帧名）
+     */
+    void setPartImage(cocos2d::Sprite* sprite, const std::string& path);
+
 private:
     const CardModel* _cardModel;        // 卡牌数据模型（const指针）
     int _cardId;                        // 卡牌ID
     CardClickCallback _clickCallback;   // 点击回调函数
-    cocos2d::Sprite* _cardSprite;       // 卡牌背景精灵
-    cocos2d::EventListenerTouchOneByOne* _touchListener;  // 触摸监听器
+    cocos2d::Sprite* _cardSprite;       // 卡牌底图精灵，有合成牌面时是唯一的精灵
+    cocos2d::Sprite* _bigNumberSprite;  // 大数字精灵，有合成牌面时为nullptr
+    cocos2d::Sprite* _smallNumberSprite;    // 小数字精灵，有合成牌面时为nullptr
+    cocos2d::Sprite* _suitSprite;       // 花色精灵，有合成牌面时为nullptr
+    bool _clickEnabled;                 // 是否可点击
 
     static const float kCardWidth;      // 卡牌宽度
     static const float kCardHeight;     // 卡牌高度
+    static const cocos2d::Color3B kBlockedColor;  // 被遮挡时的颜色
 };
 
 #endif // __CARD_VIEW_H__
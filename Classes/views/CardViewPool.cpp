@@ -0,0 +1,89 @@
+#include "CardViewPool.h"
+
+USING_NS_CC;
+
+CardViewPool::CardViewPool(int capacity)
+    : _capacity(capacity)
+{
+}
+
+CardViewPool::~CardViewPool()
+{
+}
+
+CardViewPool* CardViewPool::getInstance()
+{
+    // 池持有引擎节点，不在静态析构时释放（此时引擎可能已经销毁）
+    static CardViewPool* pool = new CardViewPool();
+    return pool;
+}
+
+CardView* CardViewPool::acquire(const CardModel* cardModel, const CardView::CardClickCallback& callback)
+{
+    if (_freeViews.empty())
+    {
+        CardView* cardView = CardView::create(cardModel, callback);
+        if (cardView) _stats.createdCount++;
+        return cardView;
+    }
+
+    // 移出池之前先交给自动释放池，与新建的视图引用计数一致
+    CardView* cardView = _freeViews.back();
+    cardView->retain();
+    cardView->autorelease();
+    _freeViews.popBack();
+    _stats.freeCount = static_cast<int>(_freeViews.size());
+    _stats.reusedCount++;
+
+    cardView->bind(cardModel, callback);
+    return cardView;
+}
+
+void CardViewPool::recycle(CardView* cardView)
+{
+    if (!cardView) return;
+
+    cardView->unbind();
+    if (static_cast<int>(_freeViews.size()) >= _capacity)
+    {
+        cardView->removeFromParent();
+        _stats.discardedCount++;
+        return;
+    }
+
+    // 先由池持有再移除，视图不会在移除时被释放
+    _freeViews.pushBack(cardView);
+    cardView->removeFromParent();
+    _stats.recycledCount++;
+    _stats.freeCount = static_cast<int>(_freeViews.size());
+    if (_stats.freeCount > _stats.peakFreeCount) _stats.peakFreeCount = _stats.freeCount;
+}
+
+void CardViewPool::resetStats()
+{
+    _stats = CardViewPoolStats();
+    _stats.freeCount = static_cast<int>(_freeViews.size());
+    _stats.peakFreeCount = _stats.freeCount;
+}
+
+void CardViewPool::clear()
+{
+    _freeViews.clear();
+    _stats.freeCount = 0;
+}
+
+void CardViewPool::setCapacity(int capacity)
+{
+    _capacity = capacity;
+    trim();
+}
+
+void CardViewPool::trim()
+{
+    while (static_cast<int>(_freeViews.size()) > _capacity)
+    {
+        _freeViews.popBack();
+        _stats.discardedCount++;
+    }
+    _stats.freeCount = static_cast<int>(_freeViews.size());
+}
@@ -0,0 +1,95 @@
+#ifndef __CARD_VIEW_POOL_H__
+#define __CARD_VIEW_POOL_H__
+
+#include "cocos2d.h"
+#include "CardView.h"
+
+class CardModel;
+
+/**
+ * @brief 卡牌视图池的统计数据
+ */
+struct CardViewPoolStats
+{
+    int createdCount;       // 池中没有空闲视图时新建的视图数量
+    int reusedCount;        // 从池中取出复用的次数
+    int recycledCount;      // 回收到池中的次数
+    int discardedCount;     // 池已满、回收时直接释放的视图数量
+    int freeCount;          // 当前空闲的视图数量
+    int peakFreeCount;      // 空闲视图数量的最大值
+
+    CardViewPoolStats()
+        : createdCount(0), reusedCount(0), recycledCount(0), discardedCount(0), freeCount(0), peakFreeCount(0) {}
+};
+
+/**
+ * @brief 卡牌视图池
+ * 关卡结束或重开时回收卡牌视图，下一局重新绑定到新的卡牌数据，沿用原有的精灵；
+ * 连续重开同一关或切换规模相近的关卡时不再新建视图
+ * 只在主线程使用
+ */
+class CardViewPool
+{
+public:
+    static const int kDefaultCapacity = 256;    // 默认最多保留的空闲视图数量
+
+    /**
+     * @param capacity 最多保留的空闲视图数量
+     */
+    explicit CardViewPool(int capacity = kDefaultCapacity);
+    ~CardViewPool();
+
+    /**
+     * @brief 获取游戏共用的视图池
+     */
+    static CardViewPool* getInstance();
+
+    /**
+     * @brief 取出一个绑定到指定卡牌的视图，池中没有空闲视图时新建
+     * 与CardView::create一样返回autorelease的对象
+     * @param cardModel 卡牌数据模型（const指针）
+     * @param callback 点击回调函数
+     * @return 卡牌视图，失败返回nullptr
+     */
+    CardView* acquire(const CardModel* cardModel, const CardView::CardClickCallback& callback);
+
+    /**
+     * @brief 回收视图：从父节点移除并解除绑定，池已满时直接释放
+     * @param cardView 卡牌视图
+     */
+    void recycle(CardView* cardView);
+
+    /**
+     * @brief 获取统计数据
+     */
+    const CardViewPoolStats& getStats() const { return _stats; }
+
+    /**
+     * @brief 清零计数，空闲视图数量保持不变
+     */
+    void resetStats();
+
+    /**
+     * @brief 释放所有空闲视图（如收到内存警告时）
+     */
+    void clear();
+
+    /**
+     * @brief 设置最多保留的空闲视图数量，超出的空闲视图立即释放
+     * @param capacity 空闲视图数量上限
+     */
+    void setCapacity(int capacity);
+
+private:
+    /**
+     * @brief 释放超出上限的空闲视图
+     */
+    void trim();
+
+private:
+    cocos2d::Vector<CardView*> _freeViews;      // 空闲视图，由池持有引用
+    int _capacity;                              // 空闲视图数量上限
+    CardViewPoolStats _stats;                   // 统计数据
+};
+
+#endif // __CARD_VIEW_POOL_H__
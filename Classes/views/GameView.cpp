@@ -1,6 +1,9 @@
 #include "GameView.h"
+#include "CardViewPool.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
+#include "../configs/models/CardResConfig.h"
+#include "../utils/CocosVecAdapter.h"
 #include "ui/CocosGUI.h"
 
 USING_NS_CC;
@@ -16,20 +19,28 @@ GameView::GameView()
     , _trayNode(nullptr)
     , _stackNode(nullptr)
     , _trayZOrder(0)
+    , _touchListener(nullptr)
+    , _touchedCardId(-1)
 {
 }
 
 GameView::~GameView()
 {
+    if (_touchListener)
+    {
+        _eventDispatcher->removeEventListener(_touchListener);
+        _touchListener = nullptr;
+    }
 }
 
 GameView* GameView::create(const GameModel* gameModel,
                           const CardClickCallback& playfieldCallback,
                           const CardClickCallback& stackCallback,
-                          const UndoClickCallback& undoCallback)
+                          const UndoClickCallback& undoCallback,
+                          const UndoClickCallback& redoCallback)
 {
     GameView* view = new (std::nothrow) GameView();
-    if (view && view->init(gameModel, playfieldCallback, stackCallback, undoCallback))
+    if (view && view->init(gameModel, playfieldCallback, stackCallback, undoCallback, redoCallback))
     {
         view->autorelease();
         return view;
@@ -41,7 +52,8 @@ GameView* GameView::create(const GameModel* gameModel,
 bool GameView::init(const GameModel* gameModel,
                    const CardClickCallback& playfieldCallback,
                    const CardClickCallback& stackCallback,
-                   const UndoClickCallback& undoCallback)
+                   const UndoClickCallback& undoCallback,
+                   const UndoClickCallback& redoCallback)
 {
     if (!Layer::init())
     {
@@ -52,16 +64,24 @@ bool GameView::init(const GameModel* gameModel,
     _playfieldCallback = playfieldCallback;
     _stackCallback = stackCallback;
     _undoCallback = undoCallback;
+    _redoCallback = redoCallback;
 
     // 设置背景色
     auto bg = LayerColor::create(Color4B(34, 139, 34, 255));
     addChild(bg, -1);
 
+    // 卡牌部件都取自同一张图集纹理，整个牌面合批绘制
+    CardView::loadCardAtlas();
+
+    // 卡牌ID在一局内从0连续分配，视图数组按卡牌数量一次分配
+    _cardViews.assign(_gameModel ? _gameModel->getCardCount() : 0, nullptr);
+
     // 创建各个区域
     createPlayfield();
     createTrayArea();
     createStackArea();
     createUIButtons();
+    setupTouchListener();
 
     return true;
 }
@@ -74,16 +94,21 @@ void GameView::createPlayfield()
 
     if (!_gameModel) return;
 
+    // 主牌区卡牌的位置在一局内不变，开局时建立点击检测用的空间索引
+    _playfieldGrid.build(_gameModel->getPlayfieldSlots(), CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+
     // 创建主牌区卡牌视图
-    const auto& playfieldCards = _gameModel->getPlayfieldCards();
+    std::vector<CardModel*> playfieldCards;
+    _gameModel->getPlayfieldCards(playfieldCards);
     for (auto cardModel : playfieldCards)
     {
-        CardView* cardView = CardView::create(cardModel, _playfieldCallback);
+        CardView* cardView = CardViewPool::getInstance()->acquire(cardModel, _playfieldCallback);
         if (cardView)
         {
-            cardView->setPosition(cardModel->getPosition());
-            _playfieldNode->addChild(cardView);
-            _cardViews[cardModel->getId()] = cardView;
+            cardView->setPosition(CocosVecAdapter::toCocos(cardModel->getPosition()));
+            cardView->setBlockedDisplay(_gameModel->isCardBlocked(cardModel->getId()));
+            _playfieldNode->addChild(cardView, cardModel->getZOrder());
+            setCardView(cardModel->getId(), cardView);
         }
     }
 }
@@ -100,13 +125,13 @@ void GameView::createTrayArea()
     CardModel* trayCard = _gameModel->getTrayCard();
     if (trayCard)
     {
-        CardView* cardView = CardView::create(trayCard, nullptr);
+        CardView* cardView = CardViewPool::getInstance()->acquire(trayCard, nullptr);
         if (cardView)
         {
             cardView->setPosition(kTrayPosition);
             cardView->setClickEnabled(false);  // 底牌不可点击
             _trayNode->addChild(cardView, _trayZOrder++);
-            _cardViews[trayCard->getId()] = cardView;
+            setCardView(trayCard->getId(), cardView);
         }
     }
 }
@@ -124,7 +149,7 @@ void GameView::createStackArea()
     for (size_t i = 0; i < stackCards.size(); i++)
     {
         CardModel* cardModel = stackCards[i];
-        CardView* cardView = CardView::create(cardModel, _stackCallback);
+        CardView* cardView = CardViewPool::getInstance()->acquire(cardModel, _stackCallback);
         if (cardView)
         {
             // 叠放效果：每张牌稍微偏移一点
@@ -135,9 +160,79 @@ void GameView::createStackArea()
             cardView->setClickEnabled(i == stackCards.size() - 1);
 
             _stackNode->addChild(cardView);
-            _cardViews[cardModel->getId()] = cardView;
+            setCardView(cardModel->getId(), cardView);
+        }
+    }
+}
+
+void GameView::setupTouchListener()
+{
+    // 监听器挂在GameView上，按钮等子节点在上层，优先收到触摸；卡牌视图移动或换父节点时不需要增删监听器
+    _touchListener = EventListenerTouchOneByOne::create();
+    _touchListener->setSwallowTouches(true);
+
+    _touchListener->onTouchBegan = [this](Touch* touch, Event* event) -> bool {
+        CardView* cardView = findCardViewAt(touch->getLocation());
+        _touchedCardId = cardView ? cardView->getCardId() : -1;
+        return cardView != nullptr;
+    };
+
+    _touchListener->onTouchEnded = [this](Touch* touch, Event* event) {
+        // 抬起时仍在按下的那张牌上才算点击
+        CardView* cardView = findCardViewAt(touch->getLocation());
+        if (cardView && cardView->getCardId() == _touchedCardId)
+        {
+            cardView->performClick();
+        }
+        _touchedCardId = -1;
+    };
+
+    _touchListener->onTouchCancelled = [this](Touch* touch, Event* event) {
+        _touchedCardId = -1;
+    };
+
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(_touchListener, this);
+}
+
+CardView* GameView::findCardViewAt(const Vec2& location)
+{
+    if (!_gameModel) return nullptr;
+
+    // 备用牌堆在主牌区上层，先检查；只有顶部的牌可能可以点击
+    const auto& stackCards = _gameModel->getStackCards();
+    if (!stackCards.empty())
+    {
+        CardView* cardView = getCardView(stackCards.back()->getId());
+        if (cardView && cardView->isClickEnabled())
+        {
+            const Vec2 locationInNode = cardView->convertToNodeSpace(location);
+            const Size& size = cardView->getContentSize();
+            if (Rect(0, 0, size.width, size.height).containsPoint(locationInNode))
+            {
+                return cardView;
+            }
         }
     }
+
+    // 主牌区：已移走（包括正在飞向底牌）的牌和撤销动画中的牌不能点击
+    const auto& playfieldSlots = _gameModel->getPlayfieldSlots();
+    const Vec2f point = CocosVecAdapter::fromCocos(_playfieldNode->convertToNodeSpace(location));
+    const int slot = _playfieldGrid.findTopmost(point, [this, &playfieldSlots](int candidate) {
+        if (!_gameModel->isPlayfieldSlotAlive(candidate)) return false;
+        CardView* cardView = getCardView(playfieldSlots[candidate]->getId());
+        return cardView && cardView->isClickEnabled();
+    });
+    return slot >= 0 ? getCardView(playfieldSlots[slot]->getId()) : nullptr;
+}
+
+void GameView::setCardView(int cardId, CardView* cardView)
+{
+    if (cardId < 0) return;
+    if (cardId >= static_cast<int>(_cardViews.size()))
+    {
+        _cardViews.resize(cardId + 1, nullptr);
+    }
+    _cardViews[cardId] = cardView;
 }
 
 void GameView::createUIButtons()
@@ -154,25 +249,44 @@ void GameView::createUIButtons()
         }
     });
     addChild(undoButton);
+
+    // 创建重做按钮
+    auto redoButton = ui::Button::create();
+    redoButton->setTitleText("重做");
+    redoButton->setTitleFontSize(36);
+    redoButton->setPosition(Vec2(880, 220));
+    redoButton->addClickEventListener([this](Ref*) {
+        if (_redoCallback)
+        {
+            _redoCallback();
+        }
+    });
+    addChild(redoButton);
 }
 
-CardView* GameView::getCardView(int cardId)
+void GameView::recycleCardViews()
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end())
+    CardViewPool* pool = CardViewPool::getInstance();
+    for (CardView* cardView : _cardViews)
     {
-        return it->second;
+        pool->recycle(cardView);
     }
-    return nullptr;
+    _cardViews.assign(_cardViews.size(), nullptr);
+}
+
+CardView* GameView::getCardView(int cardId)
+{
+    if (cardId < 0 || cardId >= static_cast<int>(_cardViews.size())) return nullptr;
+    return _cardViews[cardId];
 }
 
 void GameView::removePlayfieldCardView(int cardId)
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end())
+    CardView* cardView = getCardView(cardId);
+    if (cardView)
     {
-        it->second->removeFromParent();
-        _cardViews.erase(it);
+        cardView->removeFromParent();
+        _cardViews[cardId] = nullptr;
     }
 }
 
@@ -185,13 +299,14 @@ void GameView::addPlayfieldCardView(CardView* cardView)
 {
     if (!cardView) return;
 
-    // 从当前父节点移除后添加到主牌区
+    // 从当前父节点移除后添加到主牌区，恢复原来的层级，保证遮挡关系与显示一致
+    const CardModel* cardModel = _gameModel ? _gameModel->findCardById(cardView->getCardId()) : nullptr;
     cardView->retain();
     cardView->removeFromParent();
-    _playfieldNode->addChild(cardView);
+    _playfieldNode->addChild(cardView, cardModel ? cardModel->getZOrder() : 0);
     cardView->release();
 
-    _cardViews[cardView->getCardId()] = cardView;
+    setCardView(cardView->getCardId(), cardView);
 }
 
 void GameView::addStackCardView(CardView* cardView)
@@ -204,7 +319,22 @@ void GameView::addStackCardView(CardView* cardView)
     _stackNode->addChild(cardView);
     cardView->release();
 
-    _cardViews[cardView->getCardId()] = cardView;
+    setCardView(cardView->getCardId(), cardView);
+}
+
+void GameView::updateBlockedCardViews(const std::vector<int>& cardIds)
+{
+    if (!_gameModel) return;
+
+    for (int cardId : cardIds)
+    {
+        const CardModel* cardModel = _gameModel->findCardById(cardId);
+        CardView* cardView = getCardView(cardId);
+        if (cardModel && cardView)
+        {
+            cardView->setBlockedDisplay(_gameModel->isCardBlocked(cardId), 0.2f);
+        }
+    }
 }
 
 void GameView::updateTrayCardView(CardView* cardView)
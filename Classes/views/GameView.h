@@ -3,7 +3,8 @@
 
 #include "cocos2d.h"
 #include "CardView.h"
-#include <map>
+#include "../utils/CardSpatialGrid.h"
+#include <vector>
 #include <functional>
 
 class GameModel;
@@ -11,6 +12,7 @@ class GameModel;
 /**
  * @brief 游戏主视图类
  * 负责整个游戏界面的显示，包括主牌区、底牌区和备用牌堆
+ * 所有卡牌的点击由一个触摸监听器统一处理：主牌区通过空间索引找到最上层的卡牌，备用牌堆只检查顶部的牌
  */
 class GameView : public cocos2d::Layer
 {
@@ -27,12 +29,14 @@ public:
      * @param playfieldCallback 主牌区卡牌点击回调
      * @param stackCallback 备用牌堆卡牌点击回调
      * @param undoCallback 撤销按钮点击回调
+     * @param redoCallback 重做按钮点击回调
      * @return 游戏视图对象
      */
     static GameView* create(const GameModel* gameModel,
                            const CardClickCallback& playfieldCallback,
                            const CardClickCallback& stackCallback,
-                           const UndoClickCallback& undoCallback);
+                           const UndoClickCallback& undoCallback,
+                           const UndoClickCallback& redoCallback);
 
     /**
      * @brief 初始化游戏视图
@@ -40,7 +44,14 @@ public:
     bool init(const GameModel* gameModel,
               const CardClickCallback& playfieldCallback,
               const CardClickCallback& stackCallback,
-              const UndoClickCallback& undoCallback);
+              const UndoClickCallback& undoCallback,
+              const UndoClickCallback& redoCallback);
+
+    /**
+     * @brief 把所有卡牌视图回收到CardViewPool，供下一局复用
+     * 关卡结束、移除游戏视图之前调用
+     */
+    void recycleCardViews();
 
     /**
      * @brief 根据ID获取卡牌视图
@@ -73,6 +84,13 @@ public:
      */
     void addStackCardView(CardView* cardView);
 
+    /**
+     * @brief 按数据模型刷新指定卡牌的遮挡显示
+     * 只传入遮挡状态发生变化的卡牌，其余卡牌不受影响
+     * @param cardIds 遮挡状态变化的卡牌ID列表
+     */
+    void updateBlockedCardViews(const std::vector<int>& cardIds);
+
     /**
      * @brief 更新底牌显示
      * @param cardView 新的底牌视图
@@ -112,19 +130,43 @@ private:
      */
     void createUIButtons();
 
+    /**
+     * @brief 创建处理所有卡牌点击的触摸监听器
+     */
+    void setupTouchListener();
+
+    /**
+     * @brief 查找触摸点下可点击的最上层卡牌
+     * @param location 触摸点的世界坐标
+     * @return 卡牌视图，没有命中返回nullptr
+     */
+    CardView* findCardViewAt(const cocos2d::Vec2& location);
+
+    /**
+     * @brief 记录卡牌视图，ID超出数组范围时扩容
+     * @param cardId 卡牌ID
+     * @param cardView 卡牌视图
+     */
+    void setCardView(int cardId, CardView* cardView);
+
 private:
     const GameModel* _gameModel;                // 游戏数据模型（const指针）
     CardClickCallback _playfieldCallback;       // 主牌区点击回调
     CardClickCallback _stackCallback;           // 备用牌堆点击回调
     UndoClickCallback _undoCallback;            // 撤销按钮回调
+    UndoClickCallback _redoCallback;            // 重做按钮回调
 
     cocos2d::Node* _playfieldNode;              // 主牌区节点
     cocos2d::Node* _trayNode;                   // 底牌区节点
     cocos2d::Node* _stackNode;                  // 备用牌堆节点
 
-    std::map<int, CardView*> _cardViews;        // 卡牌ID到视图的映射
+    std::vector<CardView*> _cardViews;          // 按卡牌ID下标的视图数组，ID在一局内从0连续分配
     int _trayZOrder;                            // 底牌区下一个卡牌的z-order
 
+    CardSpatialGrid _playfieldGrid;             // 主牌区卡牌的空间索引，用于点击命中检测
+    cocos2d::EventListenerTouchOneByOne* _touchListener;    // 卡牌点击的触摸监听器
+    int _touchedCardId;                         // 按下时命中的卡牌ID，没有命中为-1
+
     static const float kPlayfieldHeight;        // 主牌区高度
     static const float kTrayAreaHeight;         // 底牌区高度
     static const cocos2d::Vec2 kTrayPosition;   // 底牌位置
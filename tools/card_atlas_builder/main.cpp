@@ -0,0 +1,441 @@
+/**
+ * @brief 卡牌图集生成命令行工具
+ * 用法: card_atlas_builder [--card-faces] --base-dir D --output P <image.png> ...
+ * --base-dir D    资源根目录，帧名为图片相对该目录的路径（如res/number/big_red_A.png），与CardResConfig中的名称一致
+ * --output P      输出路径（不含扩展名），生成P.png和cocos2d-x格式的P.plist
+ * --card-faces    另外按CardResConfig的部件摆放把底图、数字和花色合成为52张完整牌面，
+ *                 帧名为CardResConfig::getCardFaceFrameName，游戏中每张牌只需一个精灵
+ * 所有图片按高度从大到小逐行排入一张不超过2048x2048的2的幂尺寸纹理，帧之间留透明间隔，不裁剪不旋转
+ */
+
+#include "configs/models/CardResConfig.h"
+#include "models/CardModel.h"
+#include <png.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int kPadding = 2;             // 帧之间的透明间隔，避免缩放采样时混入相邻的帧
+    const int kMinTextureSize = 64;
+    const int kMaxTextureSize = 2048;   // 移动设备普遍支持的最大纹理尺寸
+
+    /**
+     * @brief 一张待打包的图片
+     */
+    struct AtlasImage
+    {
+        std::string name;               // 帧名
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;    // RGBA像素，按行存放
+        int x;                          // 在图集中的位置
+        int y;
+    };
+
+    bool readPng(const std::string& path, AtlasImage& outImage)
+    {
+        png_image image;
+        std::memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_file(&image, path.c_str())) return false;
+
+        image.format = PNG_FORMAT_RGBA;
+        outImage.width = static_cast<int>(image.width);
+        outImage.height = static_cast<int>(image.height);
+        outImage.pixels.resize(PNG_IMAGE_SIZE(image));
+        if (!png_image_finish_read(&image, nullptr, outImage.pixels.data(), 0, nullptr))
+        {
+            png_image_free(&image);
+            return false;
+        }
+        return true;
+    }
+
+    bool writePng(const std::string& path, int width, int height, const std::vector<uint8_t>& pixels)
+    {
+        png_image image;
+        std::memset(&image, 0, sizeof(image));
+        image.version = PNG_IMAGE_VERSION;
+        image.width = static_cast<png_uint_32>(width);
+        image.height = static_cast<png_uint_32>(height);
+        image.format = PNG_FORMAT_RGBA;
+        return png_image_write_to_file(&image, path.c_str(), 0, pixels.data(), 0, nullptr) != 0;
+    }
+
+    /**
+     * @brief 按给定宽度逐行排列（图片已按高度降序排列）
+     * @return 排列后的总高度，有图片宽于纹理时返回-1
+     */
+    int layoutShelves(std::vector<AtlasImage>& images, int textureWidth)
+    {
+        int x = 0;
+        int y = 0;
+        int shelfHeight = 0;
+        for (auto& image : images)
+        {
+            const int width = image.width + kPadding;
+            if (width > textureWidth) return -1;
+            if (x + width > textureWidth)
+            {
+                y += shelfHeight;
+                x = 0;
+                shelfHeight = 0;
+            }
+            image.x = x;
+            image.y = y;
+            x += width;
+            shelfHeight = std::max(shelfHeight, image.height + kPadding);
+        }
+        return y + shelfHeight;
+    }
+
+    int nextPowerOfTwo(int value)
+    {
+        int size = kMinTextureSize;
+        while (size < value) size *= 2;
+        return size;
+    }
+
+    /**
+     * @brief 选择面积最小的纹理尺寸并确定每张图片的位置
+     * @return 成功返回true，放不进最大纹理时返回false
+     */
+    bool packImages(std::vector<AtlasImage>& images, int& outWidth, int& outHeight)
+    {
+        std::stable_sort(images.begin(), images.end(), [](const AtlasImage& a, const AtlasImage& b) {
+            return a.height > b.height;
+        });
+
+        int bestWidth = 0;
+        int bestHeight = 0;
+        for (int width = kMinTextureSize; width <= kMaxTextureSize; width *= 2)
+        {
+            const int usedHeight = layoutShelves(images, width);
+            if (usedHeight < 0) continue;
+
+            const int height = nextPowerOfTwo(usedHeight);
+            if (height > kMaxTextureSize) continue;
+
+            // 面积相同时取更接近正方形的尺寸
+            const long area = static_cast<long>(width) * height;
+            const long bestArea = static_cast<long>(bestWidth) * bestHeight;
+            if (bestWidth == 0 || area < bestArea || (area == bestArea && std::max(width, height) < std::max(bestWidth, bestHeight)))
+            {
+                bestWidth = width;
+                bestHeight = height;
+            }
+        }
+        if (bestWidth == 0) return false;
+
+        layoutShelves(images, bestWidth);
+        outWidth = bestWidth;
+        outHeight = bestHeight;
+        return true;
+    }
+
+    /**
+     * @brief 按像素中心双线性采样，返回预乘alpha的颜色，图片外为透明
+     */
+    void samplePremultiplied(const AtlasImage& image, float u, float v, float outColor[4])
+    {
+        for (int c = 0; c < 4; c++) outColor[c] = 0.0f;
+
+        const int x0 = static_cast<int>(std::floor(u));
+        const int y0 = static_cast<int>(std::floor(v));
+        const float fx = u - x0;
+        const float fy = v - y0;
+        for (int dy = 0; dy < 2; dy++)
+        {
+            for (int dx = 0; dx < 2; dx++)
+            {
+                const int x = x0 + dx;
+                const int y = y0 + dy;
+                if (x < 0 || y < 0 || x >= image.width || y >= image.height) continue;
+
+                const float weight = (dx ? fx : 1.0f - fx) * (dy ? fy : 1.0f - fy);
+                const uint8_t* pixel = &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+                const float alpha = pixel[3] / 255.0f;
+                for (int c = 0; c < 3; c++) outColor[c] += weight * alpha * pixel[c] / 255.0f;
+                outColor[3] += weight * alpha;
+            }
+        }
+    }
+
+    /**
+     * @brief 把部件按摆放缩放后以正常混合叠加到牌面上
+     * 牌面与底图大小相同，底图中心即摆放中的kBackLayout位置；canvas为预乘alpha的浮点颜色
+     */
+    void drawPart(std::vector<float>& canvas, int canvasWidth, int canvasHeight,
+                  const AtlasImage& part, const CardPartLayout& layout)
+    {
+        // 卡牌节点坐标（y轴向上）换算为牌面图片坐标（y轴向下）
+        const float centerX = canvasWidth * 0.5f + (layout.x - CardResConfig::kBackLayout.x);
+        const float centerY = canvasHeight * 0.5f - (layout.y - CardResConfig::kBackLayout.y);
+        const float left = centerX - part.width * layout.scale * 0.5f;
+        const float top = centerY - part.height * layout.scale * 0.5f;
+        const float right = left + part.width * layout.scale;
+        const float bottom = top + part.height * layout.scale;
+
+        const int beginX = std::max(0, static_cast<int>(std::floor(left)));
+        const int beginY = std::max(0, static_cast<int>(std::floor(top)));
+        const int endX = std::min(canvasWidth, static_cast<int>(std::ceil(right)));
+        const int endY = std::min(canvasHeight, static_cast<int>(std::ceil(bottom)));
+        for (int y = beginY; y < endY; y++)
+        {
+            for (int x = beginX; x < endX; x++)
+            {
+                float color[4];
+                samplePremultiplied(part, (x + 0.5f - left) / layout.scale - 0.5f,
+                                    (y + 0.5f - top) / layout.scale - 0.5f, color);
+                float* dest = &canvas[(static_cast<size_t>(y) * canvasWidth + x) * 4];
+                for (int c = 0; c < 4; c++) dest[c] = color[c] + dest[c] * (1.0f - color[3]);
+            }
+        }
+    }
+
+    const AtlasImage* findImage(const std::vector<AtlasImage>& images, const std::string& name)
+    {
+        for (const auto& image : images)
+        {
+            if (image.name == name) return &image;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 合成52张完整牌面，与CardView逐个部件摆放的效果相同
+     * @return 成功返回true，缺少部件图片时返回false
+     */
+    bool composeCardFaces(std::vector<AtlasImage>& images)
+    {
+        const AtlasImage* back = findImage(images, CardResConfig::getCardBackPath());
+        if (!back)
+        {
+            std::fprintf(stderr, "%s: missing card part\n", CardResConfig::getCardBackPath().c_str());
+            return false;
+        }
+
+        std::vector<AtlasImage> faces;
+        for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; suit++)
+        {
+            for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; face++)
+            {
+                const bool isRed = CardModel(0, static_cast<CardFaceType>(face), static_cast<CardSuitType>(suit)).isRed();
+                const std::string partNames[] = {
+                    CardResConfig::getCardBigNumberPath(face, isRed),
+                    CardResConfig::getCardSmallNumberPath(face, isRed),
+                    CardResConfig::getCardSuitPath(suit)
+                };
+                const CardPartLayout* partLayouts[] = {
+                    &CardResConfig::kBigNumberLayout,
+                    &CardResConfig::kSmallNumberLayout,
+                    &CardResConfig::kSuitLayout
+                };
+
+                // 底图不缩放，直接作为画布
+                std::vector<float> canvas(back->pixels.size());
+                for (size_t i = 0; i < back->pixels.size(); i += 4)
+                {
+                    const float alpha = back->pixels[i + 3] / 255.0f;
+                    for (int c = 0; c < 3; c++) canvas[i + c] = alpha * back->pixels[i + c] / 255.0f;
+                    canvas[i + 3] = alpha;
+                }
+
+                for (int part = 0; part < 3; part++)
+                {
+                    const AtlasImage* image = findImage(images, partNames[part]);
+                    if (!image)
+                    {
+                        std::fprintf(stderr, "%s: missing card part\n", partNames[part].c_str());
+                        return false;
+                    }
+                    drawPart(canvas, back->width, back->height, *image, *partLayouts[part]);
+                }
+
+                AtlasImage composed;
+                composed.name = CardResConfig::getCardFaceFrameName(face, suit);
+                composed.width = back->width;
+                composed.height = back->height;
+                composed.x = 0;
+                composed.y = 0;
+                composed.pixels.resize(back->pixels.size());
+                for (size_t i = 0; i < canvas.size(); i += 4)
+                {
+                    // PNG保存非预乘的颜色
+                    const float alpha = canvas[i + 3];
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const float value = alpha > 0.0f ? canvas[i + c] / alpha : 0.0f;
+                        composed.pixels[i + c] = static_cast<uint8_t>(std::min(255.0f, value * 255.0f + 0.5f));
+                    }
+                    composed.pixels[i + 3] = static_cast<uint8_t>(std::min(255.0f, alpha * 255.0f + 0.5f));
+                }
+                faces.push_back(composed);
+            }
+        }
+
+        images.insert(images.end(), faces.begin(), faces.end());
+        return true;
+    }
+
+    std::string getFileName(const std::string& path)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    /**
+     * @brief 生成cocos2d-x SpriteFrameCache可以读取的plist（format 2）
+     */
+    std::string buildPlist(const std::vector<AtlasImage>& images, const std::string& textureFileName,
+                           int width, int height)
+    {
+        std::string plist =
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+            "<plist version=\"1.0\">\n"
+            "    <dict>\n"
+            "        <key>frames</key>\n"
+            "        <dict>\n";
+
+        char buffer[512];
+        for (const auto& image : images)
+        {
+            snprintf(buffer, sizeof(buffer),
+                     "            <key>%s</key>\n"
+                     "            <dict>\n"
+                     "                <key>frame</key>\n"
+                     "                <string>{{%d,%d},{%d,%d}}</string>\n"
+                     "                <key>offset</key>\n"
+                     "                <string>{0,0}</string>\n"
+                     "                <key>rotated</key>\n"
+                     "                <false/>\n"
+                     "                <key>sourceColorRect</key>\n"
+                     "                <string>{{0,0},{%d,%d}}</string>\n"
+                     "                <key>sourceSize</key>\n"
+                     "                <string>{%d,%d}</string>\n"
+                     "            </dict>\n",
+                     image.name.c_str(), image.x, image.y, image.width, image.height,
+                     image.width, image.height, image.width, image.height);
+            plist += buffer;
+        }
+
+        snprintf(buffer, sizeof(buffer),
+                 "        </dict>\n"
+                 "        <key>metadata</key>\n"
+                 "        <dict>\n"
+                 "            <key>format</key>\n"
+                 "            <integer>2</integer>\n"
+                 "            <key>realTextureFileName</key>\n"
+                 "            <string>%s</string>\n"
+                 "            <key>size</key>\n"
+                 "            <string>{%d,%d}</string>\n"
+                 "            <key>textureFileName</key>\n"
+                 "            <string>%s</string>\n"
+                 "        </dict>\n"
+                 "    </dict>\n"
+                 "</plist>\n",
+                 textureFileName.c_str(), width, height, textureFileName.c_str());
+        plist += buffer;
+        return plist;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string baseDir;
+    std::string outputPath;
+    bool cardFaces = false;
+
+    int firstPath = 1;
+    while (firstPath < argc && std::strncmp(argv[firstPath], "--", 2) == 0)
+    {
+        if (std::strcmp(argv[firstPath], "--card-faces") == 0)
+        {
+            cardFaces = true;
+            firstPath++;
+            continue;
+        }
+        if (firstPath + 1 >= argc) break;
+        if (std::strcmp(argv[firstPath], "--base-dir") == 0) baseDir = argv[firstPath + 1];
+        else if (std::strcmp(argv[firstPath], "--output") == 0) outputPath = argv[firstPath + 1];
+        else break;
+        firstPath += 2;
+    }
+
+    if (baseDir.empty() || outputPath.empty() || firstPath >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--card-faces] --base-dir <resources_dir> --output <atlas_path> <image.png> ...\n", argv[0]);
+        return 2;
+    }
+    if (baseDir.back() != '/') baseDir += '/';
+
+    std::vector<AtlasImage> images;
+    for (int i = firstPath; i < argc; i++)
+    {
+        const std::string path = argv[i];
+        if (path.compare(0, baseDir.size(), baseDir) != 0)
+        {
+            std::fprintf(stderr, "%s: not under %s\n", path.c_str(), baseDir.c_str());
+            return 1;
+        }
+
+        AtlasImage image;
+        image.name = path.substr(baseDir.size());
+        image.x = 0;
+        image.y = 0;
+        if (!readPng(path, image))
+        {
+            std::fprintf(stderr, "%s: cannot read image\n", path.c_str());
+            return 1;
+        }
+        images.push_back(image);
+    }
+
+    if (cardFaces && !composeCardFaces(images)) return 1;
+
+    int width = 0;
+    int height = 0;
+    if (!packImages(images, width, height))
+    {
+        std::fprintf(stderr, "images do not fit into a %dx%d texture\n", kMaxTextureSize, kMaxTextureSize);
+        return 1;
+    }
+
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4, 0);
+    for (const auto& image : images)
+    {
+        for (int row = 0; row < image.height; row++)
+        {
+            std::memcpy(&pixels[(static_cast<size_t>(image.y + row) * width + image.x) * 4],
+                        &image.pixels[static_cast<size_t>(row) * image.width * 4],
+                        static_cast<size_t>(image.width) * 4);
+        }
+    }
+
+    const std::string texturePath = outputPath + ".png";
+    const std::string plistPath = outputPath + ".plist";
+    if (!writePng(texturePath, width, height, pixels))
+    {
+        std::fprintf(stderr, "%s: cannot write image\n", texturePath.c_str());
+        return 1;
+    }
+
+    std::ofstream plistFile(plistPath.c_str(), std::ios::out | std::ios::binary);
+    plistFile << buildPlist(images, getFileName(texturePath), width, height);
+    if (!plistFile)
+    {
+        std::fprintf(stderr, "%s: cannot write file\n", plistPath.c_str());
+        return 1;
+    }
+
+    std::printf("%s: %d frames, %dx%d\n", plistPath.c_str(), static_cast<int>(images.size()), width, height);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @brief 卡牌空间索引的正确性测试
+ * 用法: card_spatial_grid_test
+ * 随机生成多种主牌区布局（散布、重叠的金字塔、同一位置堆叠、zOrder相同、带有远处离群卡牌），每种布局随机标记一部分卡牌不可点击，
+ * 用CardSpatialGrid::findTopmost和逐张检查的暴力查找分别计算命中的槽位，共150万次查询，结果必须完全一致
+ * 查询点包括布局内外的随机点和卡牌矩形的边缘、角点；同时检查格子数量不超过上限
+ */
+
+#include "models/CardModel.h"
+#include "utils/CardSpatialGrid.h"
+#include "utils/Vec2f.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const int kLayoutKindCount = 5;                     // 布局类型数量
+    const int kLayoutCount = 500;                       // 随机布局数量
+    const int kQueriesPerLayout = 3000;                 // 每种布局的查询次数
+    const float kCardWidth = 182.0f;                    // 卡牌尺寸
+    const float kCardHeight = 282.0f;
+    const uint32_t kSeed = 2024;                        // 随机种子
+
+    /**
+     * @brief 逐张检查，返回包含该点、可点击的最上层槽位：zOrder大的在上，相同时后加入的在上
+     */
+    int findTopmostBruteForce(const std::vector<CardModel*>& slots, const std::vector<char>& clickable, const Vec2f& point)
+    {
+        int topmost = -1;
+        for (int slot = 0; slot < static_cast<int>(slots.size()); slot++)
+        {
+            const Vec2f center = slots[slot]->getPosition();
+            if (point.x < center.x - kCardWidth * 0.5f || point.x > center.x + kCardWidth * 0.5f) continue;
+            if (point.y < center.y - kCardHeight * 0.5f || point.y > center.y + kCardHeight * 0.5f) continue;
+            if (!clickable[slot]) continue;
+
+            if (topmost < 0 || slots[slot]->getZOrder() >= slots[topmost]->getZOrder()) topmost = slot;
+        }
+        return topmost;
+    }
+
+    /**
+     * @brief 生成一种随机布局
+     * @param kind 布局类型：0散布，1重叠的金字塔，2少量位置上堆叠多张，3全部zOrder相同，
+     *             4散布并把少量卡牌放到很远的地方，网格覆盖全部卡牌时格子数量会超出上限
+     */
+    void createLayout(std::mt19937& random, int kind, std::vector<CardModel*>& outSlots)
+    {
+        std::uniform_int_distribution<int> countDistribution(1, 80);
+        std::uniform_real_distribution<float> xDistribution(0.0f, 1080.0f);
+        std::uniform_real_distribution<float> yDistribution(0.0f, 1500.0f);
+        std::uniform_int_distribution<int> zOrderDistribution(0, 5);
+
+        const int count = countDistribution(random);
+        std::vector<Vec2f> stackPositions;
+        for (int i = 0; i < 4; i++) stackPositions.push_back(Vec2f(xDistribution(random), yDistribution(random)));
+        const Vec2f outlierPositions[] = {
+            Vec2f(1.0e5f, 1.0e5f), Vec2f(-3.0e6f, 800.0f), Vec2f(500.0f, 4.0e7f), Vec2f(1.0e5f, 1.0e5f + kCardHeight * 0.5f)
+        };
+        const int outlierCount = kind == 4 ? 1 + static_cast<int>(random() % 4) : 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            CardModel* card = new CardModel(i, CFT_ACE, CST_CLUBS);
+            if (kind == 1)
+            {
+                // 金字塔：第row行有row + 1张牌，相邻两行错开半张牌，下一行压在上一行上面
+                int row = 0;
+                while ((row + 1) * (row + 2) / 2 <= i) row++;
+                const int column = i - row * (row + 1) / 2;
+                card->setPosition(Vec2f(540.0f + (column - row * 0.5f) * kCardWidth * 0.5f, 1400.0f - row * kCardHeight * 0.3f));
+                card->setZOrder(row);
+            }
+            else if (kind == 2)
+            {
+                card->setPosition(stackPositions[i % stackPositions.size()]);
+                card->setZOrder(zOrderDistribution(random));
+            }
+            else if (i < outlierCount)
+            {
+                // 离群的卡牌，其中两张互相重叠
+                card->setPosition(outlierPositions[i]);
+                card->setZOrder(zOrderDistribution(random));
+            }
+            else
+            {
+                card->setPosition(Vec2f(xDistribution(random), yDistribution(random)));
+                card->setZOrder(kind == 3 ? 0 : zOrderDistribution(random));
+            }
+            outSlots.push_back(card);
+        }
+    }
+
+    /**
+     * @brief 生成一个查询点：一半是布局附近的随机点，一半是随机卡牌矩形的边缘或角点
+     */
+    Vec2f createQueryPoint(std::mt19937& random, const std::vector<CardModel*>& slots)
+    {
+        std::uniform_int_distribution<int> kindDistribution(0, 3);
+        std::uniform_real_distribution<float> xDistribution(-200.0f, 1280.0f);
+        std::uniform_real_distribution<float> yDistribution(-200.0f, 1700.0f);
+        std::uniform_int_distribution<int> slotDistribution(0, static_cast<int>(slots.size()) - 1);
+        std::uniform_real_distribution<float> unitDistribution(-0.5f, 0.5f);
+
+        const int kind = kindDistribution(random);
+        if (kind < 2) return Vec2f(xDistribution(random), yDistribution(random));
+
+        const Vec2f center = slots[slotDistribution(random)]->getPosition();
+        const float signX = (random() & 1) ? 0.5f : -0.5f;
+        const float signY = (random() & 1) ? 0.5f : -0.5f;
+        if (kind == 2)
+        {
+            // 角点
+            return Vec2f(center.x + signX * kCardWidth, center.y + signY * kCardHeight);
+        }
+        // 边上的点
+        if (random() & 1)
+        {
+            return Vec2f(center.x + signX * kCardWidth, center.y + unitDistribution(random) * kCardHeight);
+        }
+        return Vec2f(center.x + unitDistribution(random) * kCardWidth, center.y + signY * kCardHeight);
+    }
+}
+
+int main()
+{
+    std::mt19937 random(kSeed);
+    long long queryCount = 0;
+    long long hitCount = 0;
+    int mismatchCount = 0;
+    int oversizedGridCount = 0;
+    int outlierLayoutCount = 0;
+
+    for (int layout = 0; layout < kLayoutCount; layout++)
+    {
+        std::vector<CardModel*> slots;
+        createLayout(random, layout % kLayoutKindCount, slots);
+
+        CardSpatialGrid grid;
+        grid.build(slots, kCardWidth, kCardHeight);
+
+        const int cellLimit = std::max(CardSpatialGrid::kMinCellLimit,
+                                       static_cast<int>(slots.size()) * CardSpatialGrid::kCellLimitPerCard);
+        if (grid.getCellCount() > cellLimit)
+        {
+            std::printf("layout %d: %d cells, limit %d\n", layout, grid.getCellCount(), cellLimit);
+            oversizedGridCount++;
+        }
+        if (grid.getOutlierCount() > 0) outlierLayoutCount++;
+
+        // 每种布局换几次可点击的集合，模拟卡牌逐渐被移走
+        std::vector<char> clickable(slots.size(), 1);
+        for (int query = 0; query < kQueriesPerLayout; query++)
+        {
+            if (query % 500 == 0)
+            {
+                for (char& value : clickable) value = (random() % 4) != 0;
+            }
+
+            const Vec2f point = createQueryPoint(random, slots);
+            const int expected = findTopmostBruteForce(slots, clickable, point);
+            const int actual = grid.findTopmost(point, [&clickable](int slot) { return clickable[slot] != 0; });
+
+            queryCount++;
+            if (expected >= 0) hitCount++;
+            if (expected != actual)
+            {
+                if (mismatchCount < 10)
+                {
+                    std::printf("mismatch: layout %d, point (%.3f, %.3f), expected %d, got %d\n",
+                                layout, point.x, point.y, expected, actual);
+                }
+                mismatchCount++;
+            }
+        }
+
+        for (CardModel* card : slots) delete card;
+    }
+
+    std::printf("%lld queries, %lld hits, %d mismatches, %d layouts with outliers, %d oversized grids\n",
+                queryCount, hitCount, mismatchCount, outlierLayoutCount, oversizedGridCount);
+
+    const bool passed = mismatchCount == 0 && oversizedGridCount == 0 && outlierLayoutCount > 0;
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
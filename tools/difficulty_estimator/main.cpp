@@ -0,0 +1,161 @@
+/**
+ * @brief 关卡难度评估命令行工具
+ * 用法: difficulty_estimator [--playouts N] [--threads N] [--seed N] [--policy random|greedy|playfield|all] <level.json> ...
+ * --playouts N 每个策略模拟的局数，默认100000
+ * --threads N 线程数量（0表示硬件线程数），默认0
+ * --seed N 随机种子，默认1，相同种子和局数的结果可复现
+ * --policy 出牌策略，默认all（依次使用所有策略）
+ * 对每个关卡文件打印通关率、平均抽牌次数、剩余卡牌分布和模拟速度
+ */
+
+#include "configs/models/LevelConfig.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "services/DifficultyEstimator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    bool parsePolicies(const char* name, std::vector<PlayoutPolicyType>& outPolicies)
+    {
+        outPolicies.clear();
+        for (int policy = 0; policy < PPT_NUM_POLICY_TYPES; policy++)
+        {
+            const PlayoutPolicyType type = static_cast<PlayoutPolicyType>(policy);
+            if (std::strcmp(name, "all") == 0 || std::strcmp(name, DifficultyEstimator::getPolicyName(type)) == 0)
+            {
+                outPolicies.push_back(type);
+            }
+        }
+        return !outPolicies.empty();
+    }
+
+    void printReport(const DifficultyReport& report, double elapsedMs)
+    {
+        std::printf("  %-9s win %6.2f%%  draws %6.2f  remaining %6.2f  (%.0f playouts/s)\n",
+                    DifficultyEstimator::getPolicyName(report.policy),
+                    report.getWinRate() * 100.0,
+                    report.getAverageStackDraws(),
+                    report.getAverageRemainingCards(),
+                    elapsedMs > 0 ? report.playouts * 1000.0 / elapsedMs : 0.0);
+
+        std::printf("            remaining:");
+        for (size_t remaining = 0; remaining < report.remainingHistogram.size(); remaining++)
+        {
+            if (report.remainingHistogram[remaining] == 0) continue;
+            std::printf(" %d:%.1f%%", static_cast<int>(remaining),
+                        report.remainingHistogram[remaining] * 100.0 / report.playouts);
+        }
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long long playoutCount = 100000;
+    int threadCount = 0;
+    uint64_t seed = 1;
+    std::vector<PlayoutPolicyType> policies;
+    parsePolicies("all", policies);
+
+    int firstPath = 1;
+    while (firstPath + 1 < argc && std::strncmp(argv[firstPath], "--", 2) == 0)
+    {
+        const char* option = argv[firstPath];
+        const char* value = argv[firstPath + 1];
+        if (std::strcmp(option, "--playouts") == 0)
+        {
+            playoutCount = std::atoll(value);
+        }
+        else if (std::strcmp(option, "--threads") == 0)
+        {
+            threadCount = std::atoi(value);
+        }
+        else if (std::strcmp(option, "--seed") == 0)
+        {
+            seed = std::strtoull(value, nullptr, 10);
+        }
+        else if (std::strcmp(option, "--policy") == 0)
+        {
+            if (!parsePolicies(value, policies))
+            {
+                std::fprintf(stderr, "unknown policy: %s\n", value);
+                return 2;
+            }
+        }
+        else
+        {
+            break;
+        }
+        firstPath += 2;
+    }
+
+    if (firstPath >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--playouts N] [--threads N] [--seed N] [--policy random|greedy|playfield|all] <level.json> ...\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = firstPath; i < argc; i++)
+    {
+        const char* path = argv[i];
+
+        std::string content;
+        if (!readFile(path, content))
+        {
+            std::printf("%s: cannot read file\n", path);
+            failures++;
+            continue;
+        }
+
+        LevelConfig* levelConfig = LevelConfigLoader::parseLevelConfig(content);
+        if (!levelConfig)
+        {
+            std::printf("%s: invalid level config\n", path);
+            failures++;
+            continue;
+        }
+
+        std::printf("%s: %d playfield, %d stack\n", path,
+                    static_cast<int>(levelConfig->getPlayfieldCards().size()),
+                    static_cast<int>(levelConfig->getStackCards().size()));
+
+        for (PlayoutPolicyType policy : policies)
+        {
+            DifficultyReport report;
+            auto begin = std::chrono::steady_clock::now();
+            bool succeeded = DifficultyEstimator::estimate(levelConfig, policy, playoutCount, threadCount, seed, report);
+            auto end = std::chrono::steady_clock::now();
+
+            if (!succeeded)
+            {
+                std::printf("  %s: level too large to simulate\n", DifficultyEstimator::getPolicyName(policy));
+                failures++;
+                break;
+            }
+            printReport(report, std::chrono::duration<double, std::milli>(end - begin).count());
+        }
+
+        delete levelConfig;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/**
+ * @brief 关卡编译命令行工具
+ * 用法: level_compiler [--output-dir D] <level.json> ...
+ * --output-dir D 输出目录，默认与输入文件相同
+ * 把每个关卡JSON编译为同名的.bin文件（level_N.json -> level_N.bin），游戏启动时优先映射加载.bin
+ * .bin中记录JSON的内容哈希，开发构建的游戏发现JSON改过时不使用过期的.bin
+ * 编译结果会立即重新加载校验，任意关卡失败时返回非0
+ */
+
+#include "configs/models/LevelConfig.h"
+#include "configs/models/CompiledLevel.h"
+#include "configs/models/LevelPack.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/CompiledLevelLoader.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    bool writeFile(const std::string& path, const std::string& content)
+    {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+        if (!file) return false;
+
+        file << content;
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief 计算输出路径：替换扩展名为.bin，指定输出目录时替换目录
+     */
+    std::string getOutputPath(const std::string& inputPath, const char* outputDir)
+    {
+        std::string name = inputPath;
+        const size_t slash = name.find_last_of("/\\");
+        const size_t dot = name.find_last_of('.');
+        if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+        {
+            name.erase(dot);
+        }
+        name += ".bin";
+
+        if (!outputDir) return name;
+        return std::string(outputDir) + "/" + (slash == std::string::npos ? name : name.substr(slash + 1));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* outputDir = nullptr;
+
+    int firstPath = 1;
+    while (firstPath + 1 < argc && std::strncmp(argv[firstPath], "--", 2) == 0)
+    {
+        if (std::strcmp(argv[firstPath], "--output-dir") == 0)
+        {
+            outputDir = argv[firstPath + 1];
+        }
+        else
+        {
+            break;
+        }
+        firstPath += 2;
+    }
+
+    if (firstPath >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--output-dir D] <level.json> ...\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = firstPath; i < argc; i++)
+    {
+        const char* path = argv[i];
+
+        // 编译时按位置重新计算遮挡关系，解析时不用计算
+        std::string content;
+        LevelConfig* levelConfig = readFile(path, content) ? LevelConfigLoader::parseLevelConfig(content, false) : nullptr;
+        if (!levelConfig)
+        {
+            std::fprintf(stderr, "%s: cannot load level config\n", path);
+            failures++;
+            continue;
+        }
+
+        const uint64_t sourceHash = LevelPack::computeContentHash(content.data(), content.size());
+        const std::string compiled = CompiledLevelLoader::compileLevelConfig(levelConfig, sourceHash);
+        delete levelConfig;
+
+        CompiledLevel check;
+        if (compiled.empty() || !check.openFromMemory(compiled.data(), compiled.size()))
+        {
+            std::fprintf(stderr, "%s: cannot compile level\n", path);
+            failures++;
+            continue;
+        }
+
+        const std::string outputPath = getOutputPath(path, outputDir);
+        if (!writeFile(outputPath, compiled))
+        {
+            std::fprintf(stderr, "%s: cannot write file\n", outputPath.c_str());
+            failures++;
+            continue;
+        }
+
+        std::printf("%s -> %s (%d playfield, %d stack, %d bytes)\n", path, outputPath.c_str(),
+                    check.getPlayfieldCount(), check.getStackCount(), static_cast<int>(compiled.size()));
+    }
+
+    return failures == 0 ? 0 : 1;
+}
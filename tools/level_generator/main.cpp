@@ -0,0 +1,124 @@
+/**
+ * @brief 可通关关卡批量生成命令行工具
+ * 用法: level_generator [选项] <output_dir>
+ * --count N       生成的关卡数量，默认100
+ * --cards N       每关主牌区卡牌数量，默认20
+ * --difficulty D  目标难度[0, 1]，默认0.5
+ * --verify N      校验难度的模拟局数，0表示不校验，默认256
+ * --seed N        随机种子，默认1
+ * --rows N        使用N行金字塔布局，默认6
+ * --template F    使用关卡文件F的主牌区位置和层级作为布局模板（优先于--rows）
+ * --first N       输出文件的起始编号，默认1，文件名为level_N.json
+ * 生成的关卡按构造必定可通关，输出格式与Resources/levels中的关卡文件相同
+ */
+
+#include "configs/models/LevelConfig.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "services/SolvableLevelGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    bool writeFile(const std::string& path, const std::string& content)
+    {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+        if (!file) return false;
+
+        file << content;
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    LevelGenerateParams params;
+    int count = 100;
+    int rows = 6;
+    int firstNumber = 1;
+    uint64_t seed = 1;
+    const char* templatePath = nullptr;
+
+    int argIndex = 1;
+    while (argIndex + 1 < argc && std::strncmp(argv[argIndex], "--", 2) == 0)
+    {
+        const char* option = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (std::strcmp(option, "--count") == 0) count = std::atoi(value);
+        else if (std::strcmp(option, "--cards") == 0) params.cardCount = std::atoi(value);
+        else if (std::strcmp(option, "--difficulty") == 0) params.difficulty = static_cast<float>(std::atof(value));
+        else if (std::strcmp(option, "--verify") == 0) params.verifyPlayouts = std::atoi(value);
+        else if (std::strcmp(option, "--seed") == 0) seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(option, "--rows") == 0) rows = std::atoi(value);
+        else if (std::strcmp(option, "--template") == 0) templatePath = value;
+        else if (std::strcmp(option, "--first") == 0) firstNumber = std::atoi(value);
+        else break;
+        argIndex += 2;
+    }
+
+    if (argIndex >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--count N] [--cards N] [--difficulty D] [--verify N] [--seed N] "
+                             "[--rows N | --template level.json] [--first N] <output_dir>\n", argv[0]);
+        return 2;
+    }
+    const std::string outputDir = argv[argIndex];
+
+    std::vector<CardConfigData> layoutTemplate;
+    if (templatePath)
+    {
+        std::string content;
+        LevelConfig* templateConfig = readFile(templatePath, content) ? LevelConfigLoader::parseLevelConfig(content) : nullptr;
+        if (!templateConfig)
+        {
+            std::fprintf(stderr, "%s: cannot load template\n", templatePath);
+            return 1;
+        }
+        layoutTemplate = templateConfig->getPlayfieldCards();
+        delete templateConfig;
+    }
+    else
+    {
+        layoutTemplate = SolvableLevelGenerator::createPyramidLayout(rows, 540.0f, 1500.0f);
+    }
+
+    std::vector<LevelConfig*> levels;
+    auto begin = std::chrono::steady_clock::now();
+    const int generated = SolvableLevelGenerator::generateBatch(layoutTemplate, params, seed, count, levels);
+    auto end = std::chrono::steady_clock::now();
+    double elapsedMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+    int failures = 0;
+    for (int i = 0; i < generated; i++)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "/level_%d.json", firstNumber + i);
+        if (!writeFile(outputDir + name, LevelConfigLoader::serializeLevelConfig(levels[i])))
+        {
+            std::fprintf(stderr, "%s%s: cannot write file\n", outputDir.c_str(), name);
+            failures++;
+        }
+        delete levels[i];
+    }
+
+    std::printf("generated %d/%d levels in %.2f ms (%.0f levels/min)\n", generated, count, elapsedMs,
+                elapsedMs > 0 ? generated * 60000.0 / elapsedMs : 0.0);
+    return failures == 0 && generated == count ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/**
+ * @brief 关卡打包命令行工具
+ * 用法: level_pack_builder [--lz4] --output F <level_N.json|level_N.bin> ...
+ * --lz4       用LZ4压缩每个关卡
+ * --output F  输出的关卡包文件，游戏中的路径为levels/levels.pack
+ * 关卡ID取自文件名中的数字（level_12.json -> 12）；JSON文件先编译再打包，.bin文件校验后直接打包
+ * 打包结果会立即重新加载并逐关解码校验，任意关卡失败时返回非0
+ */
+
+#include "configs/models/CompiledLevel.h"
+#include "configs/models/LevelConfig.h"
+#include "configs/models/LevelPack.h"
+#include "configs/loaders/CompiledLevelLoader.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/LevelPackLoader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    bool writeFile(const std::string& path, const std::string& content)
+    {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+        if (!file) return false;
+
+        file << content;
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief 从文件名解析关卡ID（最后一个'_'之后的数字）
+     * @return 成功返回true
+     */
+    bool parseLevelId(const std::string& path, int& outLevelId)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        const size_t underscore = name.find_last_of('_');
+        if (underscore == std::string::npos) return false;
+
+        const char* digits = name.c_str() + underscore + 1;
+        char* end = nullptr;
+        const long levelId = std::strtol(digits, &end, 10);
+        if (end == digits || (*end != '.' && *end != '\0')) return false;
+
+        outLevelId = static_cast<int>(levelId);
+        return true;
+    }
+
+    bool hasExtension(const std::string& path, const char* extension)
+    {
+        const size_t length = std::strlen(extension);
+        return path.size() >= length && path.compare(path.size() - length, length, extension) == 0;
+    }
+
+    /**
+     * @brief 读取一个关卡并得到编译后的数据
+     * @return 成功返回true
+     */
+    bool loadCompiledData(const char* path, std::string& outCompiled)
+    {
+        std::string content;
+        if (!readFile(path, content)) return false;
+
+        if (hasExtension(path, ".bin"))
+        {
+            CompiledLevel check;
+            if (!check.openFromMemory(content.data(), content.size())) return false;
+            outCompiled.swap(content);
+            return true;
+        }
+
+        // 原地解析会改写内容，先记下JSON的哈希
+        const uint64_t sourceHash = LevelPack::computeContentHash(content.data(), content.size());
+        // 编译时按位置重新计算遮挡关系，解析时不用计算
+        LevelConfig* levelConfig = LevelConfigLoader::parseLevelConfigInPlace(content, false);
+        if (!levelConfig) return false;
+
+        outCompiled = CompiledLevelLoader::compileLevelConfig(levelConfig, sourceHash);
+        delete levelConfig;
+        return !outCompiled.empty();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* outputPath = nullptr;
+    bool compress = false;
+
+    int firstPath = 1;
+    while (firstPath < argc && std::strncmp(argv[firstPath], "--", 2) == 0)
+    {
+        if (std::strcmp(argv[firstPath], "--lz4") == 0)
+        {
+            compress = true;
+            firstPath++;
+        }
+        else if (std::strcmp(argv[firstPath], "--output") == 0 && firstPath + 1 < argc)
+        {
+            outputPath = argv[firstPath + 1];
+            firstPath += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (!outputPath || firstPath >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--lz4] --output <levels.pack> <level_N.json|level_N.bin> ...\n", argv[0]);
+        return 2;
+    }
+
+    std::map<int, std::string> compiledLevels;
+    size_t rawBytes = 0;
+    int failures = 0;
+    for (int i = firstPath; i < argc; i++)
+    {
+        const char* path = argv[i];
+
+        int levelId = 0;
+        if (!parseLevelId(path, levelId))
+        {
+            std::fprintf(stderr, "%s: cannot determine level id from file name\n", path);
+            failures++;
+            continue;
+        }
+        if (compiledLevels.count(levelId) > 0)
+        {
+            std::fprintf(stderr, "%s: duplicate level id %d\n", path, levelId);
+            failures++;
+            continue;
+        }
+
+        std::string compiled;
+        if (!loadCompiledData(path, compiled))
+        {
+            std::fprintf(stderr, "%s: cannot load level\n", path);
+            failures++;
+            continue;
+        }
+        rawBytes += compiled.size();
+        compiledLevels[levelId].swap(compiled);
+    }
+    if (failures > 0) return 1;
+
+    const std::string packData = LevelPackLoader::buildLevelPack(compiledLevels, compress);
+
+    // 重新加载并逐关解码，确认打包结果可用
+    LevelPack check;
+    if (packData.empty() || !check.openFromMemory(packData.data(), packData.size())
+        || check.getLevelCount() != static_cast<int>(compiledLevels.size()))
+    {
+        std::fprintf(stderr, "%s: cannot build level pack\n", outputPath);
+        return 1;
+    }
+    for (const auto& level : compiledLevels)
+    {
+        CompiledLevel decoded;
+        if (!check.loadLevel(level.first, decoded))
+        {
+            std::fprintf(stderr, "level %d: cannot decode from pack\n", level.first);
+            failures++;
+        }
+    }
+    if (failures > 0) return 1;
+
+    if (!writeFile(outputPath, packData))
+    {
+        std::fprintf(stderr, "%s: cannot write file\n", outputPath);
+        return 1;
+    }
+
+    std::printf("%s: %d levels, %d bytes (%d bytes uncompressed)\n", outputPath, check.getLevelCount(),
+                static_cast<int>(packData.size()), static_cast<int>(rawBytes));
+    return 0;
+}
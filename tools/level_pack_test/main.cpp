@@ -0,0 +1,242 @@
+/**
+ * @brief 关卡包与LZ4编解码的往返测试
+ * 用法: level_pack_test
+ * 用生成器生成一批关卡并编译，分别以压缩和不压缩方式打包，重新打开后逐关解码，与打包前的数据逐字节比较
+ * 另外检查：不在包中的关卡ID查找失败；索引中解压大小超出上限的关卡包被拒绝；关卡数据损坏时解码失败；
+ * Lz4Codec对各类数据的压缩解压结果与原始数据一致，长度不符或被截断的压缩数据解压失败
+ */
+
+#include "configs/models/CompiledLevel.h"
+#include "configs/models/LevelConfig.h"
+#include "configs/models/LevelPack.h"
+#include "configs/loaders/CompiledLevelLoader.h"
+#include "configs/loaders/LevelPackLoader.h"
+#include "services/SolvableLevelGenerator.h"
+#include "utils/Lz4Codec.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int kLevelCount = 24;                         // 打包的关卡数量
+    const int kLevelIdStep = 3;                         // 关卡ID间隔，中间的ID不在包中
+    const uint64_t kSeed = 7;                           // 随机种子
+
+    /**
+     * @brief 比较两个关卡的全部数据
+     * @return 一致返回true
+     */
+    bool isSameLevel(const CompiledLevel& a, const CompiledLevel& b)
+    {
+        if (a.getPlayfieldCount() != b.getPlayfieldCount()) return false;
+        if (a.getStackCount() != b.getStackCount()) return false;
+        if (a.getCoinReward() != b.getCoinReward()) return false;
+        if (a.getSourceHash() != b.getSourceHash()) return false;
+
+        if (std::memcmp(a.getPlayfieldCards(), b.getPlayfieldCards(), sizeof(CompiledCardData) * a.getPlayfieldCount()) != 0) return false;
+        if (std::memcmp(a.getStackCards(), b.getStackCards(), sizeof(CompiledCardData) * a.getStackCount()) != 0) return false;
+
+        for (int i = 0; i < a.getPlayfieldCount(); i++)
+        {
+            const CompiledCardData& card = a.getPlayfieldCards()[i];
+            if (std::memcmp(a.getBlockers(card), b.getBlockers(b.getPlayfieldCards()[i]), sizeof(uint16_t) * card.blockerCount) != 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 读写关卡包中的一个索引项（关卡包内容为std::string，用memcpy避免对齐问题）
+     */
+    LevelPackEntry readEntry(const std::string& pack, int index)
+    {
+        LevelPackHeader header;
+        std::memcpy(&header, pack.data(), sizeof(header));
+
+        LevelPackEntry entry;
+        std::memcpy(&entry, pack.data() + header.indexOffset + sizeof(LevelPackEntry) * index, sizeof(entry));
+        return entry;
+    }
+
+    void writeEntry(std::string& pack, int index, const LevelPackEntry& entry)
+    {
+        LevelPackHeader header;
+        std::memcpy(&header, pack.data(), sizeof(header));
+        std::memcpy(&pack[header.indexOffset + sizeof(LevelPackEntry) * index], &entry, sizeof(entry));
+    }
+
+    /**
+     * @brief 打包、重新打开并逐关比较
+     * @return 通过返回true
+     */
+    bool checkRoundTrip(const std::map<int, std::string>& compiledLevels, bool compress, std::string& outPack)
+    {
+        outPack = LevelPackLoader::buildLevelPack(compiledLevels, compress);
+        LevelPack levelPack;
+        if (outPack.empty() || !levelPack.openFromMemory(outPack.data(), outPack.size()))
+        {
+            std::printf("FAILED: cannot open pack (compress %d)\n", compress ? 1 : 0);
+            return false;
+        }
+        if (levelPack.getLevelCount() != static_cast<int>(compiledLevels.size()))
+        {
+            std::printf("FAILED: pack has %d levels, expected %d\n", levelPack.getLevelCount(), static_cast<int>(compiledLevels.size()));
+            return false;
+        }
+
+        for (const auto& item : compiledLevels)
+        {
+            CompiledLevel source;
+            CompiledLevel decoded;
+            if (!source.openFromMemory(item.second.data(), item.second.size())
+             || !levelPack.loadLevel(item.first, decoded)
+             || !isSameLevel(source, decoded))
+            {
+                std::printf("FAILED: level %d differs after round trip (compress %d)\n", item.first, compress ? 1 : 0);
+                return false;
+            }
+            if (levelPack.hasLevel(item.first + 1))
+            {
+                std::printf("FAILED: level %d should not be in the pack\n", item.first + 1);
+                return false;
+            }
+        }
+
+        std::printf("pack (compress %d): %d levels, %d bytes\n", compress ? 1 : 0,
+                    levelPack.getLevelCount(), static_cast<int>(outPack.size()));
+        return true;
+    }
+
+    /**
+     * @brief 检查损坏的关卡包：解压大小超出上限时打开失败，关卡数据损坏时解码失败
+     * @return 通过返回true
+     */
+    bool checkCorruptPack(const std::string& pack)
+    {
+        const LevelPackEntry entry = readEntry(pack, 0);
+        if ((entry.flags & kLevelPackEntryLz4) == 0)
+        {
+            std::printf("FAILED: first level is not compressed\n");
+            return false;
+        }
+
+        LevelPack levelPack;
+        bool passed = true;
+
+        // 超过LZ4的最大压缩比
+        std::string corrupt = pack;
+        LevelPackEntry badEntry = entry;
+        badEntry.rawSize = entry.storedSize * kLevelPackMaxLz4Ratio + 1;
+        writeEntry(corrupt, 0, badEntry);
+        if (levelPack.openFromMemory(corrupt.data(), corrupt.size()))
+        {
+            std::printf("FAILED: raw size above the LZ4 ratio was accepted\n");
+            passed = false;
+        }
+
+        // 超过单关上限
+        corrupt = pack;
+        badEntry = entry;
+        badEntry.rawSize = kLevelPackMaxRawSize + 1;
+        badEntry.storedSize = kLevelPackMaxRawSize;
+        writeEntry(corrupt, 0, badEntry);
+        if (levelPack.openFromMemory(corrupt.data(), corrupt.size()))
+        {
+            std::printf("FAILED: raw size above the per-level limit was accepted\n");
+            passed = false;
+        }
+
+        // 解压大小在合理范围内但与实际不符，以及关卡数据被改动，打开成功但解码失败
+        corrupt = pack;
+        badEntry = entry;
+        badEntry.rawSize = entry.rawSize + 8;
+        writeEntry(corrupt, 0, badEntry);
+        CompiledLevel level;
+        if (!levelPack.openFromMemory(corrupt.data(), corrupt.size()) || levelPack.loadLevel(entry.levelId, level))
+        {
+            std::printf("FAILED: wrong raw size should open but fail to decode\n");
+            passed = false;
+        }
+
+        corrupt = pack;
+        corrupt[entry.offset + entry.storedSize / 2] ^= 0x5A;
+        if (!levelPack.openFromMemory(corrupt.data(), corrupt.size()) || levelPack.loadLevel(entry.levelId, level))
+        {
+            std::printf("FAILED: corrupt level data was decoded\n");
+            passed = false;
+        }
+        return passed;
+    }
+
+    /**
+     * @brief 检查一块数据的LZ4往返，以及长度不符和截断的压缩数据解压失败
+     * @return 通过返回true
+     */
+    bool checkLz4(const char* name, const std::string& data)
+    {
+        const std::string compressed = Lz4Codec::compress(data.data(), data.size());
+        std::vector<char> output(data.size() + 1);
+
+        bool passed = Lz4Codec::decompress(compressed.data(), compressed.size(), output.data(), data.size())
+                   && std::memcmp(output.data(), data.data(), data.size()) == 0;
+        passed = passed && !Lz4Codec::decompress(compressed.data(), compressed.size(), output.data(), data.size() + 1);
+        if (!data.empty())
+        {
+            passed = passed && !Lz4Codec::decompress(compressed.data(), compressed.size(), output.data(), data.size() - 1);
+            passed = passed && !Lz4Codec::decompress(compressed.data(), compressed.size() - 1, output.data(), data.size());
+        }
+
+        std::printf("lz4 %s: %d -> %d bytes, %s\n", name, static_cast<int>(data.size()),
+                    static_cast<int>(compressed.size()), passed ? "ok" : "FAILED");
+        return passed;
+    }
+}
+
+int main()
+{
+    LevelGenerateParams params;
+    params.cardCount = 40;
+    params.difficulty = 0.5f;
+
+    std::vector<LevelConfig*> levels;
+    const std::vector<CardConfigData> layoutTemplate = SolvableLevelGenerator::createPyramidLayout(8, 540.0f, 1500.0f);
+    const int generated = SolvableLevelGenerator::generateBatch(layoutTemplate, params, kSeed, kLevelCount, levels);
+
+    std::map<int, std::string> compiledLevels;
+    for (int i = 0; i < generated; i++)
+    {
+        compiledLevels[1 + i * kLevelIdStep] = CompiledLevelLoader::compileLevelConfig(levels[i], static_cast<uint64_t>(i + 1));
+    }
+    for (LevelConfig* level : levels) delete level;
+
+    if (generated != kLevelCount)
+    {
+        std::printf("FAILED: generated only %d levels\n", generated);
+        return 1;
+    }
+
+    std::string plainPack;
+    std::string compressedPack;
+    bool passed = checkRoundTrip(compiledLevels, false, plainPack);
+    passed = checkRoundTrip(compiledLevels, true, compressedPack) && passed;
+    passed = passed && checkCorruptPack(compressedPack);
+
+    std::mt19937 random(static_cast<uint32_t>(kSeed));
+    std::string noise(100000, '\0');
+    for (char& c : noise) c = static_cast<char>(random());
+    std::string text;
+    while (text.size() < 100000) text += "{\"CardFace\": 12, \"CardSuit\": 3, \"Position\": {\"x\": 540, \"y\": 1500}},\n";
+
+    passed = checkLz4("empty", std::string()) && passed;
+    passed = checkLz4("short", std::string("abc")) && passed;
+    passed = checkLz4("zeros", std::string(100000, '\0')) && passed;
+    passed = checkLz4("noise", noise) && passed;
+    passed = checkLz4("text", text) && passed;
+    passed = checkLz4("pack", plainPack) && passed;
+
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
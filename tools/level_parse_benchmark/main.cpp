@@ -0,0 +1,310 @@
+/**
+ * @brief 关卡JSON解析性能对比工具
+ * 用法: level_parse_benchmark [--rows N] [--iterations N] [level.json ...]
+ * --rows N        未指定关卡文件时，生成N行金字塔布局的关卡用于测试，默认40（820张主牌）
+ * --iterations N  每个关卡重复解析的次数，默认200
+ * 对比LevelConfigLoader的SAX解析（原地解析和只读解析）与原来基于DOM的解析，结果不一致时返回非0
+ * 原地解析用的缓冲区在计时前准备好，与loadLevelConfig直接解析读出的文件内容一致，复制不计入耗时
+ * 计时只包含JSON解析，不计算遮挡关系（与原来的DOM解析一致）；遮挡计算两种方式相同，单独计时输出
+ */
+
+#include "configs/models/CardResConfig.h"
+#include "configs/models/LevelConfig.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "services/SolvableLevelGenerator.h"
+#include "utils/CardOcclusionUtils.h"
+#include "json/document.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    CardConfigData parseCardDom(const rapidjson::Value& card, bool isPlayfield)
+    {
+        CardConfigData data;
+
+        if (card.HasMember("CardFace") && card["CardFace"].IsInt())
+            data.cardFace = card["CardFace"].GetInt();
+
+        if (card.HasMember("CardSuit") && card["CardSuit"].IsInt())
+            data.cardSuit = card["CardSuit"].GetInt();
+
+        if (card.HasMember("Position") && card["Position"].IsObject())
+        {
+            const rapidjson::Value& pos = card["Position"];
+            if (pos.HasMember("x") && pos.HasMember("y"))
+            {
+                data.position.x = pos["x"].GetFloat();
+                data.position.y = pos["y"].GetFloat();
+            }
+        }
+
+        if (isPlayfield && card.HasMember("ZOrder") && card["ZOrder"].IsInt())
+            data.zOrder = card["ZOrder"].GetInt();
+
+        if (isPlayfield && card.HasMember("IsFaceUp") && card["IsFaceUp"].IsBool())
+            data.isFaceUp = card["IsFaceUp"].GetBool();
+
+        return data;
+    }
+
+    /**
+     * @brief 原来基于DOM的解析，作为对比基准，不计算遮挡关系
+     */
+    LevelConfig* parseLevelConfigDom(const std::string& jsonStr)
+    {
+        rapidjson::Document doc;
+        doc.Parse(jsonStr.c_str());
+        if (doc.HasParseError()) return nullptr;
+
+        LevelConfig* config = new LevelConfig();
+
+        if (doc.HasMember("Playfield") && doc["Playfield"].IsArray())
+        {
+            const rapidjson::Value& playfield = doc["Playfield"];
+            std::vector<CardConfigData> playfieldCards;
+            for (rapidjson::SizeType i = 0; i < playfield.Size(); i++)
+            {
+                playfieldCards.push_back(parseCardDom(playfield[i], true));
+            }
+            config->setPlayfieldCards(playfieldCards);
+        }
+
+        if (doc.HasMember("Stack") && doc["Stack"].IsArray())
+        {
+            const rapidjson::Value& stack = doc["Stack"];
+            std::vector<CardConfigData> stackCards;
+            for (rapidjson::SizeType i = 0; i < stack.Size(); i++)
+            {
+                stackCards.push_back(parseCardDom(stack[i], false));
+            }
+            config->setStackCards(stackCards);
+        }
+
+        if (doc.HasMember("CoinReward") && doc["CoinReward"].IsInt())
+        {
+            config->setCoinReward(doc["CoinReward"].GetInt());
+        }
+
+        return config;
+    }
+
+    bool cardsEqual(const std::vector<CardConfigData>& a, const std::vector<CardConfigData>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (a[i].cardFace != b[i].cardFace || a[i].cardSuit != b[i].cardSuit
+                || a[i].position.x != b[i].position.x || a[i].position.y != b[i].position.y
+                || a[i].zOrder != b[i].zOrder || a[i].isFaceUp != b[i].isFaceUp
+                || a[i].blockedBy != b[i].blockedBy)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool configsEqual(const LevelConfig* a, const LevelConfig* b)
+    {
+        if (!a || !b) return a == b;
+        return cardsEqual(a->getPlayfieldCards(), b->getPlayfieldCards())
+            && cardsEqual(a->getStackCards(), b->getStackCards())
+            && a->getCoinReward() == b->getCoinReward();
+    }
+
+    LevelConfig* parseLevelConfigSax(const std::string& jsonStr)
+    {
+        return LevelConfigLoader::parseLevelConfig(jsonStr, false);
+    }
+
+    /**
+     * @brief 检查解析时计算的遮挡关系与对DOM结果单独计算的一致
+     */
+    bool occlusionEqual(const LevelConfig* domConfig, const std::string& json)
+    {
+        LevelConfig* saxConfig = LevelConfigLoader::parseLevelConfig(json);
+        if (!saxConfig) return false;
+
+        std::vector<CardConfigData> cards = domConfig->getPlayfieldCards();
+        CardOcclusionUtils::computeBlockedBy(cards, CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+        const bool same = cardsEqual(cards, saxConfig->getPlayfieldCards());
+        delete saxConfig;
+        return same;
+    }
+
+    /**
+     * @brief 重复解析并返回平均每次的耗时（微秒）
+     */
+    template <typename ParseFunc>
+    double measure(const std::string& json, int iterations, ParseFunc parse)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            delete parse(json);
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    /**
+     * @brief 重复原地解析并返回平均每次的耗时（微秒）
+     * 每次解析用一份独立的缓冲区，在计时前全部复制好
+     */
+    double measureInPlace(const std::string& json, int iterations)
+    {
+        std::vector<std::string> buffers(iterations, json);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            delete LevelConfigLoader::parseLevelConfigInPlace(buffers[i], false);
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    /**
+     * @brief 遮挡计算的平均耗时（微秒），不计入解析耗时
+     */
+    double measureOcclusion(const LevelConfig* levelConfig, int iterations)
+    {
+        std::vector<CardConfigData> cards = levelConfig->getPlayfieldCards();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            CardOcclusionUtils::computeBlockedBy(cards, CardResConfig::kCardWidth, CardResConfig::kCardHeight);
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    double ratio(double baseline, double time)
+    {
+        return time > 0.0 ? baseline / time : 0.0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int rows = 40;
+    int iterations = 200;
+
+    int argIndex = 1;
+    while (argIndex + 1 < argc && std::strncmp(argv[argIndex], "--", 2) == 0)
+    {
+        const char* option = argv[argIndex];
+        const char* value = argv[argIndex + 1];
+        if (std::strcmp(option, "--rows") == 0) rows = std::atoi(value);
+        else if (std::strcmp(option, "--iterations") == 0) iterations = std::atoi(value);
+        else break;
+        argIndex += 2;
+    }
+    if (rows <= 0 || iterations <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [--rows N] [--iterations N] [level.json ...]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::string> levels;
+    for (int i = argIndex; i < argc; i++)
+    {
+        std::string content;
+        if (!readFile(argv[i], content))
+        {
+            std::fprintf(stderr, "%s: cannot read file\n", argv[i]);
+            return 1;
+        }
+        names.push_back(argv[i]);
+        levels.push_back(content);
+    }
+
+    if (levels.empty())
+    {
+        // 生成器产出的最大关卡：整个金字塔都放主牌，不做难度校验
+        LevelGenerateParams params;
+        params.cardCount = rows * (rows + 1) / 2;
+        params.verifyPlayouts = 0;
+        const std::vector<CardConfigData> layout = SolvableLevelGenerator::createPyramidLayout(rows, 540.0f, 1800.0f);
+        for (uint64_t seed = 1; seed <= 4; seed++)
+        {
+            LevelConfig* levelConfig = SolvableLevelGenerator::generate(layout, params, seed);
+            if (!levelConfig) continue;
+
+            char name[64];
+            snprintf(name, sizeof(name), "generated rows=%d seed=%d", rows, static_cast<int>(seed));
+            names.push_back(name);
+            levels.push_back(LevelConfigLoader::serializeLevelConfig(levelConfig));
+            delete levelConfig;
+        }
+    }
+
+    int failures = 0;
+    double totalDom = 0.0;
+    double totalSax = 0.0;
+    double totalSaxConst = 0.0;
+    double totalOcclusion = 0.0;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        const std::string& json = levels[i];
+
+        LevelConfig* domConfig = parseLevelConfigDom(json);
+        LevelConfig* saxConfig = parseLevelConfigSax(json);
+        const bool same = configsEqual(domConfig, saxConfig) && domConfig && occlusionEqual(domConfig, json);
+        if (!same || !saxConfig)
+        {
+            std::fprintf(stderr, "%s: SAX and DOM results differ\n", names[i].c_str());
+            delete domConfig;
+            delete saxConfig;
+            failures++;
+            continue;
+        }
+
+        const int cardCount = static_cast<int>(saxConfig->getPlayfieldCards().size() + saxConfig->getStackCards().size());
+        const double occlusionTime = measureOcclusion(saxConfig, iterations);
+        delete domConfig;
+        delete saxConfig;
+
+        const double domTime = measure(json, iterations, parseLevelConfigDom);
+        const double saxTime = measureInPlace(json, iterations);
+        const double saxConstTime = measure(json, iterations, parseLevelConfigSax);
+        totalDom += domTime;
+        totalSax += saxTime;
+        totalSaxConst += saxConstTime;
+        totalOcclusion += occlusionTime;
+
+        std::printf("%s: %d cards, %d bytes, occlusion %.1f us\n"
+                    "  DOM %.1f us, SAX in place %.1f us, %.2fx, SAX read-only %.1f us, %.2fx\n",
+                    names[i].c_str(), cardCount, static_cast<int>(json.size()), occlusionTime,
+                    domTime, saxTime, ratio(domTime, saxTime), saxConstTime, ratio(domTime, saxConstTime));
+    }
+
+    if (totalSax > 0.0)
+    {
+        std::printf("total: DOM %.1f us, occlusion %.1f us\n"
+                    "  SAX in place %.1f us, %.2fx\n"
+                    "  SAX read-only %.1f us, %.2fx\n",
+                    totalDom, totalOcclusion,
+                    totalSax, ratio(totalDom, totalSax),
+                    totalSaxConst, ratio(totalDom, totalSaxConst));
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * @brief 关卡求解命令行工具
+ * 用法: level_solver [--threads N] <level.json> [<level.json> ...]
+ * --threads N 使用N个线程并行求解（0表示硬件线程数），不指定时单线程求解
+ * 对每个关卡文件运行LevelSolver，打印是否可通关、通关步骤和耗时
+ * 任意关卡无解或加载失败时返回非0，便于在CI中校验所有关卡
+ */
+
+#include "configs/models/LevelConfig.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "services/LevelSolver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    const char* kFaceNames[] = {"A", "2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K"};
+
+    bool readFile(const char* path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file) return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        outContent = buffer.str();
+        return true;
+    }
+
+    const char* faceName(int face)
+    {
+        return (face >= 0 && face < 13) ? kFaceNames[face] : "?";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int firstPath = 1;
+    int threadCount = 1;
+    if (argc > 2 && std::strcmp(argv[1], "--threads") == 0)
+    {
+        threadCount = std::atoi(argv[2]);
+        firstPath = 3;
+    }
+
+    if (firstPath >= argc)
+    {
+        std::fprintf(stderr, "usage: %s [--threads N] <level.json> [<level.json> ...]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int i = firstPath; i < argc; i++)
+    {
+        const char* path = argv[i];
+
+        std::string content;
+        if (!readFile(path, content))
+        {
+            std::printf("%s: cannot read file\n", path);
+            failures++;
+            continue;
+        }
+
+        LevelConfig* levelConfig = LevelConfigLoader::parseLevelConfig(content);
+        if (!levelConfig)
+        {
+            std::printf("%s: invalid level config\n", path);
+            failures++;
+            continue;
+        }
+
+        SolverResult result;
+        auto begin = std::chrono::steady_clock::now();
+        bool solved = threadCount == 1
+                    ? LevelSolver::solve(levelConfig, result)
+                    : LevelSolver::solveParallel(levelConfig, threadCount, result);
+        auto end = std::chrono::steady_clock::now();
+        double elapsedMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+        std::printf("%s: %s (%d playfield, %d stack, %lld states, %.2f ms)\n",
+                    path, solved ? "SOLVABLE" : "UNSOLVABLE",
+                    static_cast<int>(levelConfig->getPlayfieldCards().size()),
+                    static_cast<int>(levelConfig->getStackCards().size()),
+                    result.exploredStates, elapsedMs);
+
+        if (solved)
+        {
+            for (size_t step = 0; step < result.moves.size(); step++)
+            {
+                const SolverMove& move = result.moves[step];
+                std::printf("  %3d. %-9s card %d (%s)\n", static_cast<int>(step + 1),
+                            move.type == SMT_STACK_TO_TRAY ? "stack" : "playfield",
+                            move.cardId, faceName(move.cardFace));
+            }
+        }
+        else
+        {
+            failures++;
+        }
+
+        delete levelConfig;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * @brief 关卡求解回归测试
+ * 用法: level_solver_test
+ * 用与level_generator --count 200 --cards 66 --rows 11 --difficulty 0.8相同的参数生成关卡，
+ * 取其中搜索量最大的第176关（按构造必定可通关），分别单线程和多线程求解
+ * 检查能否求解、通关走法能否在开局局面上逐步执行，以及单线程搜索的局面数是否在预算内
+ * 置换表过小、已访问局面被覆盖时，该关卡需要搜索十亿以上的局面，本测试会因超出预算失败
+ */
+
+#include "configs/models/LevelConfig.h"
+#include "models/GameModel.h"
+#include "models/PackedGameState.h"
+#include "services/GameModelGenerator.h"
+#include "services/LevelSolver.h"
+#include "services/SolvableLevelGenerator.h"
+#include "utils/CardMatchUtils.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    const int kLevelCount = 200;                        // 生成的关卡数量
+    const int kLevelIndex = 175;                        // 测试的关卡下标（level_176）
+    const int kCardCount = 66;                          // 主牌区卡牌数量
+    const int kPyramidRows = 11;                        // 金字塔布局行数
+    const float kDifficulty = 0.8f;                     // 目标难度
+    const uint64_t kSeed = 1;                           // 随机种子
+    const long long kMaxExploredStates = 10000000;      // 单线程搜索的局面数预算（实际约306万）
+
+    /**
+     * @brief 在开局局面上逐步执行通关走法，检查每一步是否合法且最终清空主牌区
+     * @return 走法合法返回true
+     */
+    bool replayMoves(const LevelConfig* levelConfig, const std::vector<SolverMove>& moves)
+    {
+        GameModel* gameModel = GameModelGenerator::generateFromLevelConfig(levelConfig);
+        PackedGameLayout layout;
+        bool valid = gameModel && layout.buildFromGameModel(gameModel);
+        delete gameModel;
+        if (!valid) return false;
+
+        PackedGameState state = PackedGameState::createInitial(layout);
+        for (const SolverMove& move : moves)
+        {
+            if (move.type == SMT_STACK_TO_TRAY)
+            {
+                if (state.stackCursor >= layout.getStackCount()) return false;
+                if (layout.getStackCardId(state.stackCursor) != move.cardId) return false;
+                state.moveStackCardToTray(layout);
+                continue;
+            }
+
+            const int slot = layout.findPlayfieldSlot(move.cardId);
+            if (slot < 0 || !state.isPlayfieldCardExposed(layout, slot)) return false;
+
+            const int face = layout.getPlayfieldFace(slot);
+            if (!CardMatchUtils::canMatchFace(static_cast<CardFaceType>(face), static_cast<CardFaceType>(state.trayFace))) return false;
+            state.movePlayfieldCardToTray(slot, face);
+        }
+        return state.isPlayfieldEmpty();
+    }
+
+    /**
+     * @brief 求解并检查结果
+     * @param threadCount 线程数量，1表示单线程求解
+     * @param maxExploredStates 搜索的局面数上限，小于0表示不检查
+     * @return 通过返回true
+     */
+    bool checkSolve(const LevelConfig* levelConfig, int threadCount, long long maxExploredStates)
+    {
+        SolverResult result;
+        auto begin = std::chrono::steady_clock::now();
+        const bool solved = threadCount == 1
+                          ? LevelSolver::solve(levelConfig, result)
+                          : LevelSolver::solveParallel(levelConfig, threadCount, result);
+        auto end = std::chrono::steady_clock::now();
+        double elapsedMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+        std::printf("threads %d: %s, %lld states, %.2f ms\n", threadCount,
+                    solved ? "SOLVABLE" : "UNSOLVABLE", result.exploredStates, elapsedMs);
+
+        if (!solved)
+        {
+            std::printf("FAILED: level should be solvable\n");
+            return false;
+        }
+        if (!replayMoves(levelConfig, result.moves))
+        {
+            std::printf("FAILED: solution moves are not legal\n");
+            return false;
+        }
+        if (maxExploredStates >= 0 && result.exploredStates > maxExploredStates)
+        {
+            std::printf("FAILED: explored %lld states, budget is %lld\n", result.exploredStates, maxExploredStates);
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    LevelGenerateParams params;
+    params.cardCount = kCardCount;
+    params.difficulty = kDifficulty;
+
+    std::vector<LevelConfig*> levels;
+    const std::vector<CardConfigData> layoutTemplate = SolvableLevelGenerator::createPyramidLayout(kPyramidRows, 540.0f, 1500.0f);
+    const int generated = SolvableLevelGenerator::generateBatch(layoutTemplate, params, kSeed, kLevelCount, levels);
+    if (generated <= kLevelIndex)
+    {
+        std::printf("FAILED: generated only %d levels\n", generated);
+        for (LevelConfig* level : levels) delete level;
+        return 1;
+    }
+
+    const LevelConfig* levelConfig = levels[kLevelIndex];
+    std::printf("level_%d: %d playfield, %d stack\n", kLevelIndex + 1,
+                static_cast<int>(levelConfig->getPlayfieldCards().size()),
+                static_cast<int>(levelConfig->getStackCards().size()));
+
+    // 多线程的搜索量取决于线程调度，只检查结果
+    bool passed = checkSolve(levelConfig, 1, kMaxExploredStates);
+    passed = checkSolve(levelConfig, 4, -1) && passed;
+
+    for (LevelConfig* level : levels) delete level;
+
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,450 @@
+/**
+ * @brief 性能跟踪的并发压力测试
+ * 用法: trace_utils_test
+ * 4个线程不停记录事件，同时另外两个线程反复导出和清空；每次导出都解析JSON，检查格式正确、
+ * 每个线程的事件按记录顺序排列且数量不超过缓冲区容量、耗时区间的各字段来自同一次记录（没有读到写了一半的事件）
+ * 之后在静止状态下检查清空后新记录的事件全部导出、缓冲区写满后只保留最新的事件
+ * 本目标单独编译TraceUtils.cpp并定义GAME_ENABLE_TRACE，与GAME_ENABLE_TRACE选项无关；
+ * 用-DGAME_TRACE_TEST_TSAN=ON配置时以ThreadSanitizer构建，检查读写之间的数据竞争
+ */
+
+#include "utils/TraceUtils.h"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef GAME_ENABLE_TRACE
+#error "trace_utils_test must be built with GAME_ENABLE_TRACE"
+#endif
+
+namespace
+{
+    const int kWriterCount = 4;                         // 记录事件的线程数量
+    const int kStressEvents = 300000;                   // 压力阶段每个线程记录的事件数量
+    const int kFinalEvents = 1000;                      // 清空后每个线程记录的事件数量
+    const int kOverflowEvents = TraceUtils::kBufferCapacity + 500;  // 写满缓冲区的事件数量
+
+    const char* const kStressNames[kWriterCount] = {"StressWriter0", "StressWriter1", "StressWriter2", "StressWriter3"};
+    const char* const kFinalNames[kWriterCount] = {"FinalWriter0", "FinalWriter1", "FinalWriter2", "FinalWriter3"};
+
+    /**
+     * @brief 解析后的JSON值，数字保留原文
+     */
+    struct JsonValue
+    {
+        enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+        Type type = NUL;
+        std::string text;                                           // 字符串内容或数字原文
+        std::vector<JsonValue> items;                               // 数组元素
+        std::map<std::string, JsonValue> members;                   // 对象成员
+
+        const JsonValue* find(const char* key) const
+        {
+            auto it = members.find(key);
+            return it == members.end() ? nullptr : &it->second;
+        }
+    };
+
+    /**
+     * @brief 按JSON语法严格解析，只为检查导出结果，不追求速度
+     */
+    class JsonParser
+    {
+    public:
+        explicit JsonParser(const std::string& json) : _json(json), _pos(0) {}
+
+        bool parse(JsonValue& outValue)
+        {
+            if (!parseValue(outValue)) return false;
+            skipSpace();
+            return _pos == _json.size();
+        }
+
+    private:
+        void skipSpace()
+        {
+            while (_pos < _json.size() && std::strchr(" \t\r\n", _json[_pos])) _pos++;
+        }
+
+        bool consume(char c)
+        {
+            skipSpace();
+            if (_pos >= _json.size() || _json[_pos] != c) return false;
+            _pos++;
+            return true;
+        }
+
+        bool parseString(std::string& out)
+        {
+            if (!consume('"')) return false;
+            while (_pos < _json.size())
+            {
+                const unsigned char c = static_cast<unsigned char>(_json[_pos++]);
+                if (c == '"') return true;
+                if (c < 0x20) return false;
+                if (c != '\\')
+                {
+                    out += static_cast<char>(c);
+                    continue;
+                }
+                if (_pos >= _json.size()) return false;
+                const char escaped = _json[_pos++];
+                if (escaped == 'u')
+                {
+                    if (_pos + 4 > _json.size()) return false;
+                    for (int i = 0; i < 4; i++)
+                    {
+                        if (!std::isxdigit(static_cast<unsigned char>(_json[_pos + i]))) return false;
+                    }
+                    out += static_cast<char>(std::strtol(_json.substr(_pos, 4).c_str(), nullptr, 16));
+                    _pos += 4;
+                }
+                else if (std::strchr("\"\\/bfnrt", escaped))
+                {
+                    out += escaped;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        bool parseNumber(std::string& out)
+        {
+            const size_t begin = _pos;
+            if (_pos < _json.size() && _json[_pos] == '-') _pos++;
+            size_t digits = 0;
+            while (_pos < _json.size() && std::isdigit(static_cast<unsigned char>(_json[_pos]))) { _pos++; digits++; }
+            if (digits == 0) return false;
+            if (_pos < _json.size() && _json[_pos] == '.')
+            {
+                _pos++;
+                digits = 0;
+                while (_pos < _json.size() && std::isdigit(static_cast<unsigned char>(_json[_pos]))) { _pos++; digits++; }
+                if (digits == 0) return false;
+            }
+            out = _json.substr(begin, _pos - begin);
+            return true;
+        }
+
+        bool parseValue(JsonValue& outValue)
+        {
+            skipSpace();
+            if (_pos >= _json.size()) return false;
+
+            const char c = _json[_pos];
+            if (c == '{')
+            {
+                outValue.type = JsonValue::OBJECT;
+                _pos++;
+                if (consume('}')) return true;
+                do
+                {
+                    std::string key;
+                    skipSpace();
+                    if (!parseString(key) || !consume(':')) return false;
+                    if (outValue.members.count(key)) return false;
+                    if (!parseValue(outValue.members[key])) return false;
+                } while (consume(','));
+                return consume('}');
+            }
+            if (c == '[')
+            {
+                outValue.type = JsonValue::ARRAY;
+                _pos++;
+                if (consume(']')) return true;
+                do
+                {
+                    outValue.items.emplace_back();
+                    if (!parseValue(outValue.items.back())) return false;
+                } while (consume(','));
+                return consume(']');
+            }
+            if (c == '"')
+            {
+                outValue.type = JsonValue::STRING;
+                return parseString(outValue.text);
+            }
+            for (const char* literal : {"null", "true", "false"})
+            {
+                const size_t length = std::strlen(literal);
+                if (_json.compare(_pos, length, literal) == 0)
+                {
+                    outValue.type = literal[0] == 'n' ? JsonValue::NUL : JsonValue::BOOL;
+                    _pos += length;
+                    return true;
+                }
+            }
+            outValue.type = JsonValue::NUMBER;
+            return parseNumber(outValue.text);
+        }
+
+        const std::string& _json;
+        size_t _pos;
+    };
+
+    /**
+     * @brief 一次导出中某个线程的事件统计
+     */
+    struct ThreadEvents
+    {
+        std::string name;
+        std::vector<long long> values;
+    };
+
+    /**
+     * @brief 解析并检查一次导出的结果
+     * @param json 导出的JSON
+     * @param outThreads 输出参数，按线程名统计的事件参数
+     * @param outError 输出参数，失败时的原因
+     * @return 通过返回true
+     */
+    bool checkExport(const std::string& json, std::map<std::string, ThreadEvents>& outThreads, std::string& outError)
+    {
+        JsonValue root;
+        if (!JsonParser(json).parse(root) || root.type != JsonValue::OBJECT)
+        {
+            outError = "malformed JSON";
+            return false;
+        }
+        const JsonValue* events = root.find("traceEvents");
+        if (!events || events->type != JsonValue::ARRAY)
+        {
+            outError = "missing traceEvents";
+            return false;
+        }
+
+        // 线程名在该线程的事件之前导出
+        std::map<std::string, std::string> threadNames;
+        for (const JsonValue& event : events->items)
+        {
+            const JsonValue* ph = event.find("ph");
+            const JsonValue* tid = event.find("tid");
+            const JsonValue* name = event.find("name");
+            if (!ph || !tid || !name || event.find("pid") == nullptr)
+            {
+                outError = "event without ph/pid/tid/name";
+                return false;
+            }
+
+            if (ph->text == "M")
+            {
+                const JsonValue* args = event.find("args");
+                const JsonValue* threadName = args ? args->find("name") : nullptr;
+                if (name->text != "thread_name" || !threadName)
+                {
+                    outError = "bad metadata event";
+                    return false;
+                }
+                threadNames[tid->text] = threadName->text;
+                continue;
+            }
+
+            const JsonValue* ts = event.find("ts");
+            const JsonValue* args = event.find("args");
+            const JsonValue* value = args ? args->find("value") : nullptr;
+            if (!ts || ts->type != JsonValue::NUMBER || !value || value->type != JsonValue::NUMBER)
+            {
+                outError = "event without ts or value";
+                return false;
+            }
+
+            const long long index = std::atoll(value->text.c_str());
+            const char* expectedPhase = (index % 3 == 0) ? "X" : (index % 3 == 1) ? "C" : "i";
+            static const char* const kEventNames[] = {"span", "counter", "instant"};
+            if (ph->text != expectedPhase || name->text != kEventNames[index % 3])
+            {
+                outError = "event type does not match its value: " + name->text + " " + value->text;
+                return false;
+            }
+
+            // 耗时区间的开始时间和耗时都由序号决定，任何字段来自另一次记录都会不一致
+            if (ph->text == "X")
+            {
+                const JsonValue* dur = event.find("dur");
+                const std::string expectedTs = std::to_string(index) + ".000";
+                char expectedDur[16];
+                std::snprintf(expectedDur, sizeof(expectedDur), "0.%03lld", index % 1000);
+                if (!dur || ts->text != expectedTs || dur->text != expectedDur)
+                {
+                    outError = "torn span event at index " + value->text;
+                    return false;
+                }
+            }
+
+            auto it = threadNames.find(tid->text);
+            if (it == threadNames.end())
+            {
+                outError = "event from an unnamed thread";
+                return false;
+            }
+            ThreadEvents& thread = outThreads[it->second];
+            thread.name = it->second;
+            if (!thread.values.empty() && thread.values.back() >= index)
+            {
+                outError = "events of " + it->second + " are out of order";
+                return false;
+            }
+            thread.values.push_back(index);
+            if (thread.values.size() > static_cast<size_t>(TraceUtils::kBufferCapacity))
+            {
+                outError = "more events than the buffer capacity";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 记录第index个事件，事件类型和参数都由序号决定，导出时据此检查
+     */
+    void recordEvent(long long index)
+    {
+        switch (index % 3)
+        {
+        case 0:
+            TraceUtils::recordSpan("span", static_cast<uint64_t>(index) * 1000,
+                                   static_cast<uint64_t>(index) * 1000 + index % 1000, true, index);
+            break;
+        case 1:
+            TraceUtils::recordCounter("counter", index);
+            break;
+        default:
+            TraceUtils::recordInstant("instant", true, index);
+            break;
+        }
+    }
+
+    /**
+     * @brief 启动kWriterCount个线程，各自设置线程名后记录eventCount个事件
+     */
+    void runWriters(const char* const* names, int eventCount)
+    {
+        std::vector<std::thread> writers;
+        for (int i = 0; i < kWriterCount; i++)
+        {
+            const char* name = names[i];
+            writers.emplace_back([name, eventCount]() {
+                TraceUtils::setThreadName(name);
+                for (long long index = 0; index < eventCount; index++) recordEvent(index);
+            });
+        }
+        for (std::thread& writer : writers) writer.join();
+    }
+
+    /**
+     * @brief 检查某个线程导出的事件恰好是序号[first, first + count)
+     */
+    bool checkValues(const std::map<std::string, ThreadEvents>& threads, const char* name, long long first, long long count)
+    {
+        auto it = threads.find(name);
+        const size_t size = it == threads.end() ? 0 : it->second.values.size();
+        if (size != static_cast<size_t>(count))
+        {
+            std::printf("FAILED: %s exported %d events, expected %lld\n", name, static_cast<int>(size), count);
+            return false;
+        }
+        for (long long i = 0; i < count; i++)
+        {
+            if (it->second.values[i] != first + i)
+            {
+                std::printf("FAILED: %s event %lld has index %lld, expected %lld\n", name, i, it->second.values[i], first + i);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    bool passed = true;
+
+    // 压力阶段：记录、导出、清空同时进行
+    std::atomic<bool> writing(true);
+    std::atomic<int> exportCount(0);
+    std::atomic<int> clearCount(0);
+    std::string exportError;
+
+    std::thread exporter([&]() {
+        while (writing.load())
+        {
+            std::map<std::string, ThreadEvents> threads;
+            std::string error;
+            if (!checkExport(TraceUtils::exportChromeTrace(), threads, error))
+            {
+                exportError = error;
+                return;
+            }
+            exportCount++;
+        }
+    });
+    std::thread clearer([&]() {
+        while (writing.load())
+        {
+            TraceUtils::clear();
+            clearCount++;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    runWriters(kStressNames, kStressEvents);
+    writing.store(false);
+    exporter.join();
+    clearer.join();
+
+    std::printf("stress: %d writers x %d events, %d exports, %d clears\n",
+                kWriterCount, kStressEvents, exportCount.load(), clearCount.load());
+    if (!exportError.empty())
+    {
+        std::printf("FAILED: %s\n", exportError.c_str());
+        passed = false;
+    }
+
+    // 静止后清空，再记录的事件全部导出，之前的事件不再出现
+    TraceUtils::clear();
+    runWriters(kFinalNames, kFinalEvents);
+
+    std::map<std::string, ThreadEvents> threads;
+    std::string error;
+    if (!checkExport(TraceUtils::exportChromeTrace(), threads, error))
+    {
+        std::printf("FAILED: %s\n", error.c_str());
+        passed = false;
+    }
+    for (int i = 0; i < kWriterCount; i++)
+    {
+        passed = checkValues(threads, kStressNames[i], 0, 0) && passed;
+        passed = checkValues(threads, kFinalNames[i], 0, kFinalEvents) && passed;
+    }
+
+    // 写满缓冲区后只保留最新的kBufferCapacity个事件
+    TraceUtils::clear();
+    std::thread overflowWriter([]() {
+        TraceUtils::setThreadName("OverflowWriter");
+        for (long long index = 0; index < kOverflowEvents; index++) recordEvent(index);
+    });
+    overflowWriter.join();
+
+    threads.clear();
+    if (!checkExport(TraceUtils::exportChromeTrace(), threads, error))
+    {
+        std::printf("FAILED: %s\n", error.c_str());
+        passed = false;
+    }
+    passed = checkValues(threads, "OverflowWriter", kOverflowEvents - TraceUtils::kBufferCapacity, TraceUtils::kBufferCapacity) && passed;
+
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}